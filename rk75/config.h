@@ -7,6 +7,8 @@
 // #define WEAR_LEVELING_BACKING_SIZE 4096 // defined in keyboard.json
 
 // #define LED_CAPS_LOCK_PIN C4 // defined in keyboard.json
+// LED supply, switched by keymaps/pwx/utils/rgb_driver.c
+#define LED_ENABLE_PIN A5
 #define LED_WIN_LOCK_PIN B9
 #define LED_MAC_PIN B8
 
@@ -20,14 +22,30 @@
 #define EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN C12
 // #define WEAR_LEVELING_BACKING_SIZE // defined in keyboard.json
 #define WEAR_LEVELING_LOGICAL_SIZE (WEAR_LEVELING_BACKING_SIZE / 2)
+// 8-byte log entries, as written by QMK's spi_flash backend
+#define BACKING_STORE_WRITE_SIZE 8
+
+/* External flash layout: sector 0 backs wear leveling. QMK's spi_flash
+ * wear-leveling backend erases the whole first 64 KB block on every
+ * compaction, so the keymap's regions start in the second one. */
+#define USAGE_STATS_FLASH_ADDRESS 0x10000
+#define USAGE_STATS_FLASH_SECTORS 2
+#define MACRO_STORE_FLASH_ADDRESS 0x12000
+#define MACRO_STORE_FLASH_SECTORS 8
 
 /* RGB Matrix */
 #define RGB_MATRIX_FRAMEBUFFER_EFFECTS
 #define RGB_MATRIX_KEYPRESSES
+// Chunks QMK renders one per main loop pass; keymaps/pwx/utils/rgb_scheduler.c
+// adds more while they fit the pass's time budget
+#define RGB_MATRIX_LED_PROCESS_LIMIT 8
 
 /* WS2812 */
 #define WS2812_SPI_DRIVER SPIDM2
 #define WS2812_SPI_DIVISOR 32
+// Frames are sent from the keymap's output thread, which waits for each
+// transfer (keymaps/pwx/utils/rgb_driver.c)
+#define WS2812_SPI_SYNC
 
 // Set defaults for LED matrix
 #define RGB_MATRIX_DEFAULT_MODE RGB_MATRIX_SOLID_COLOR
@@ -36,5 +54,6 @@
 #define RGB_MATRIX_DEFAULT_VAL 128
 #define RGB_MATRIX_MAXIMUM_BRIGHTNESS 200
 
-// Default debounce time
+// Debounce window of a healthy key; keys that chatter get longer ones
+// (keymaps/pwx/utils/adaptive_debounce.h)
 #define DEBOUNCE 5
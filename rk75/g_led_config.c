@@ -1,40 +0,0 @@
-#include "rgb_matrix.h"
-#include "quantum.h"
-
-led_config_t g_led_config = {
-    // Key-to-LED index mapping
-    {
-        {21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, NO_LED},   // Row 1
-        {22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 7},      // Row 2
-        {49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 6},      // Row 3
-        {50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, NO_LED, 62, 5},  // Row 4
-        {75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, NO_LED, 63, NO_LED}, // Row 5
-        {76, 77, 78, NO_LED, NO_LED, 79, NO_LED, NO_LED, NO_LED, 0, 1, NO_LED, 2, 3, 4} // Row 6
-    },
-
-    // LED X/Y positions for each LED
-    {
-        {144, 64}, {160, 64}, {192, 64}, {208, 64}, {224, 64}, {224, 38},
-        {224, 26}, {224, 13}, {208, 0}, {192, 0}, {176, 0}, {160, 0},
-        {144, 0}, {128, 0}, {112, 0}, {96, 0}, {80, 0}, {64, 0},
-        {48, 0}, {32, 0}, {16, 0}, {0, 0}, {0, 13}, {16, 13},
-        {32, 13}, {48, 13}, {64, 13}, {80, 13}, {96, 13}, {112, 13},
-        {128, 13}, {144, 13}, {160, 13}, {176, 13}, {192, 13}, {208, 13},
-        {208, 26}, {192, 26}, {176, 26}, {160, 26}, {144, 26}, {128, 26},
-        {112, 26}, {96, 26}, {80, 26}, {64, 26}, {48, 26}, {32, 26},
-        {16, 26}, {0, 26}, {0, 38}, {16, 38}, {32, 38}, {48, 38},
-        {64, 38}, {80, 38}, {96, 38}, {112, 38}, {128, 38}, {144, 38},
-        {160, 38}, {176, 38}, {208, 38}, {208, 51}, {176, 51}, {160, 51},
-        {144, 51}, {128, 51}, {112, 51}, {96, 51}, {80, 51}, {64, 51},
-        {48, 51}, {32, 51}, {16, 51}, {0, 51}, {0, 64}, {16, 64},
-        {32, 64}, {80, 64}
-    },
-
-    // LED flags
-    {
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4
-    }
-};
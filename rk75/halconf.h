@@ -6,4 +6,16 @@
 #define HAL_USE_SPI TRUE
 #define PAL_USE_CALLBACKS TRUE
 
+#if defined(EVENT_TRACE_ENABLE)
+// UART3 carries the keymap's event trace; the output queue absorbs bursts.
+#    define HAL_USE_SERIAL TRUE
+#    define SERIAL_BUFFERS_SIZE 1024
+#endif
+
+#if defined(SCAN_THREAD_ENABLE)
+// TIM2 paces the keymap's matrix scan thread and TIM3 times its column
+// settling.
+#    define HAL_USE_GPT TRUE
+#endif
+
 #include_next <halconf.h>
@@ -4,16 +4,46 @@
 #include QMK_KEYBOARD_H
 #include "action_util.h"
 #include "bootloader.h"
-#include "deferred_exec.h"
 #include "eeconfig.h"
+#if defined(CLOCK_GOVERNOR_ENABLE)
+#    include "utils/clock_governor.h"
+#endif
+#if defined(CYCLE_BENCH_ENABLE)
+#    include "utils/cycle_bench.h"
+#endif
+#include "utils/adaptive_debounce.h"
+#include "utils/boot_profile.h"
+#include "utils/encoder_accel.h"
+#include "utils/encoder_quadrature.h"
+#include "utils/event_trace.h"
+#include "utils/fast_resume.h"
+#include "utils/game_mode.h"
 #include "utils/indicators.h"
+#include "utils/key_time.h"
+#include "utils/light_stream.h"
+#include "utils/macro_store.h"
+#include "utils/matrix_scan.h"
+#include "utils/reactive_keys.h"
+#include "utils/rgb_driver.h"
+#include "utils/rgb_scheduler.h"
+#if defined(SCAN_THREAD_ENABLE)
+#    include "utils/scan_thread.h"
+#endif
 #include "utils/sentence_case.h"
 #include "utils/socd_cleaner.h"
+#include "utils/timer_wheel.h"
+#include "utils/usage_stats.h"
+#include "utils/wear_leveling_metrics.h"
+#include "utils/hid_commands.h"
 #include "rgb_matrix.h"
 #include "progmem.h"
 #if defined(VIA_ENABLE) && defined(ENCODER_BUTTONS_ENABLE)
 #    include "dynamic_keymap.h"
 #endif
+#if defined(VIA_ENABLE)
+#    include "raw_hid.h"
+#    include "via.h"
+#endif
 
 void clear_keyboard_but_mods(void);
 #if defined(NKRO_ENABLE)
@@ -34,36 +64,62 @@ enum custom_keycodes {
     CLEAR_EEPROM_KEY,
     NIGHT_MODE_TOG,
     NIGHT_MODE_SAVE,
+    SNIPPET_1,
+    SNIPPET_2,
+    SNIPPET_3,
+    SNIPPET_4,
+    SNIPPET_5,
+    SNIPPET_6,
+    SNIPPET_7,
+    SNIPPET_8,
+    GAME_MODE_TOG,
+    CUSTOM_KEYCODE_END,
 };
 
+_Static_assert(CUSTOM_KEYCODE_END - SAFE_RANGE <= USAGE_STATS_CUSTOM_KEYCODES, "usage_stats: raise USAGE_STATS_CUSTOM_KEYCODES");
+_Static_assert(SNIPPET_8 - SNIPPET_1 < MACRO_STORE_SLOTS, "macro_store: raise MACRO_STORE_SLOTS");
+
 static bool winlock_enabled = false;
 static bool nkro_enabled = false;
 static socd_mode_t socd_mode = SOCD_MODE_LAST;
 static bool night_mode_active = false;
 
-static deferred_token dfu_token = INVALID_DEFERRED_TOKEN;
-static deferred_token eeprom_token = INVALID_DEFERRED_TOKEN;
+static timer_wheel_handle_t dfu_timer = TIMER_WHEEL_INVALID;
+static timer_wheel_handle_t eeprom_timer = TIMER_WHEEL_INVALID;
 
 static void restore_encoder_button_defaults_if_needed(void);
 
 socd_cleaner_t socd_v = {{KC_W, KC_S}, SOCD_CLEANER_LAST, {false, false}, SOCD_FIRST_NONE};
 socd_cleaner_t socd_h = {{KC_A, KC_D}, SOCD_CLEANER_LAST, {false, false}, SOCD_FIRST_NONE};
 
+// The user EEPROM word: the Night preset and the game mode profile. A
+// change to the layout takes a new version, and the load converts older
+// ones rather than resetting them.
 typedef union {
     uint32_t raw;
     struct {
         uint8_t night_h;
         uint8_t night_s;
         uint8_t night_v;
-        uint8_t flags;
+        bool    game_mode : 1;
+        bool    game_nkro : 1; // NKRO setting from before game mode
+        uint8_t reserved : 2;
+        uint8_t version : 4;
     };
 } night_config_t;
 
+_Static_assert(sizeof(night_config_t) == sizeof(uint32_t), "night_config_t must fit the user EEPROM word");
+
 static night_config_t night_config;
 
-enum {
-    NIGHT_CONFIG_FLAG_VALID = 0xA5,
-};
+// Version 1 had no version field: the whole last byte was 0xA5, and game
+// mode later kept its two flags in bits that are clear in that pattern.
+// Both start 0xA, which later versions never do, nor do erased or cleared
+// words.
+#define NIGHT_CONFIG_VERSION 2
+#define NIGHT_CONFIG_V1_VALID 0xA5
+#define NIGHT_CONFIG_V1_GAME_MODE 0x02
+#define NIGHT_CONFIG_V1_GAME_NKRO 0x08
 
 static HSV night_config_default_hsv(void) {
     return (HSV){.h = 16, .s = 165, .v = 26};
@@ -82,7 +138,7 @@ static void night_config_set_hsv(HSV hsv, bool write_back) {
     night_config.night_h = hsv.h;
     night_config.night_s = hsv.s;
     night_config.night_v = hsv.v;
-    night_config.flags = NIGHT_CONFIG_FLAG_VALID;
+    night_config.version = NIGHT_CONFIG_VERSION;
     indicators_set_night_hsv(hsv);
     if (write_back) {
         night_config_write();
@@ -98,7 +154,16 @@ static void night_config_set_defaults(void) {
 
 static void night_config_load(void) {
     night_config.raw = eeconfig_read_user();
-    if (night_config.flags != NIGHT_CONFIG_FLAG_VALID) {
+    uint8_t v1       = night_config.raw >> 24;
+    if ((v1 & ~(NIGHT_CONFIG_V1_GAME_MODE | NIGHT_CONFIG_V1_GAME_NKRO)) == NIGHT_CONFIG_V1_VALID) {
+        night_config.game_mode = v1 & NIGHT_CONFIG_V1_GAME_MODE;
+        night_config.game_nkro = v1 & NIGHT_CONFIG_V1_GAME_NKRO;
+        night_config.reserved  = 0;
+        night_config.version   = NIGHT_CONFIG_VERSION;
+        night_config_write();
+    }
+    if (night_config.version != NIGHT_CONFIG_VERSION) {
+        night_config.raw = 0;
         night_config_set_defaults();
     } else {
         HSV stored = {.h = night_config.night_h, .s = night_config.night_s, .v = night_config.night_v};
@@ -169,16 +234,40 @@ static void apply_socd_mode(socd_mode_t mode, bool trigger_feedback) {
     indicators_set_socd_mode(mode, trigger_feedback);
 }
 
-static uint32_t dfu_deferred_callback(uint32_t trigger_time, void *context) {
-    (void)trigger_time;
-    (void)context;
+static void set_game_mode(bool enabled, bool write_back) {
+    if (enabled == game_mode_active()) {
+        return;
+    }
+    if (enabled) {
+        // Restored from EEPROM at boot, the flag is already set and the NKRO
+        // bit still holds the setting from before.
+        if (!night_config.game_mode) {
+            night_config.game_nkro = nkro_enabled;
+        }
+        night_config.game_mode = true;
+        set_nkro_state(true, false);
+        const uint16_t socd_keys[] = {socd_v.keys[0], socd_v.keys[1], socd_h.keys[0], socd_h.keys[1]};
+        game_mode_enter(socd_keys, ARRAY_SIZE(socd_keys));
+    } else {
+        game_mode_exit();
+        set_nkro_state(night_config.game_nkro, false);
+        night_config.game_mode = false;
+        night_config.game_nkro = false;
+    }
+    if (write_back) {
+        night_config_write();
+    }
+}
+
+static uint32_t dfu_timer_callback(void *arg) {
+    (void)arg;
     bootloader_jump();
     return 0;
 }
 
-static uint32_t eeprom_deferred_callback(uint32_t trigger_time, void *context) {
-    (void)trigger_time;
-    (void)context;
+static uint32_t eeprom_timer_callback(void *arg) {
+    (void)arg;
+    set_game_mode(false, false);
     eeconfig_init();
     eeconfig_read_keymap(&keymap_config);
     sentence_case_off();
@@ -190,7 +279,7 @@ static uint32_t eeprom_deferred_callback(uint32_t trigger_time, void *context) {
     socd_cleaner_enabled = true;
     night_config_set_defaults();
     restore_encoder_button_defaults_if_needed();
-    eeprom_token = INVALID_DEFERRED_TOKEN;
+    eeprom_timer = TIMER_WHEEL_INVALID;
     soft_reset_keyboard();
     return 0;
 }
@@ -260,7 +349,7 @@ _______,  _______,  _______,
 _______,  _______,  _______,
         _______,  _______,  _______,  _______,  _______,  _______,  _______,  _______,  _______,  _______,  _______,  _______,
 _______,  _______,  _______,
-        _______,  _______,  SOCD_MODE_TOG, _______, _______, _______, _______, _______, _______, _______, _______, _______,
+        _______,  _______,  SOCD_MODE_TOG, _______, _______, GAME_MODE_TOG, _______, _______, _______, _______, _______, _______,
        _______, _______,
         _______,  _______,  _______,  _______,  _______,  _______,  NKRO_MODE_TOG, _______, _______, _______, _______, _______,
          _______,
@@ -333,25 +422,184 @@ static void restore_encoder_button_defaults_if_needed(void) {
 }
 // clang-format on
 
+// Start-up work that typing does not depend on runs after the first scans,
+// one step per millisecond so no single loop iteration stalls.
+static uint32_t deferred_init_callback(void *arg) {
+    static uint8_t step = 0;
+    (void)arg;
+    switch (step++) {
+        case 0:
+            boot_profile_mark(BOOT_MARK_ENCODER_DEFAULTS);
+            restore_encoder_button_defaults_if_needed();
+            return 1;
+        case 1:
+            boot_profile_mark(BOOT_MARK_USAGE_STATS);
+            usage_stats_load();
+            return 1;
+        default:
+            boot_profile_mark(BOOT_MARK_MACRO_STORE);
+            macro_store_load();
+            boot_profile_mark(BOOT_MARK_DEFERRED_DONE);
+            return 0;
+    }
+}
+
 void keyboard_post_init_user(void) {
+    boot_profile_mark(BOOT_MARK_POST_INIT);
+#if defined(SCAN_THREAD_ENABLE)
+    scan_thread_init();
+#endif
     sentence_case_off();
     indicators_set_sentence_case(false);
     set_winlock(false);
     set_nkro_state(keymap_config.nkro, false);
     apply_socd_mode(SOCD_MODE_LAST, false);
     socd_cleaner_enabled = true;
+    boot_profile_mark(BOOT_MARK_NIGHT_CONFIG);
     night_config_load();
-    restore_encoder_button_defaults_if_needed();
+    if (night_config.game_mode) {
+        set_game_mode(true, false);
+    }
+    timer_wheel_schedule(1, deferred_init_callback, NULL);
+    boot_profile_mark(BOOT_MARK_POST_INIT_DONE);
 }
 
-bool process_record_user(uint16_t keycode, keyrecord_t *record) {
-    if (!process_socd_cleaner(keycode, record, &socd_v)) {
+void suspend_power_down_user(void) {
+    // Housekeeping stops while the host sleeps; timers keep their deadlines.
+    timer_wheel_task();
+    fast_resume_suspend();
+#if defined(CLOCK_GOVERNOR_ENABLE)
+    clock_governor_suspend();
+#endif
+}
+
+void suspend_wakeup_init_user(void) {
+#if defined(CLOCK_GOVERNOR_ENABLE)
+    clock_governor_demand();
+#endif
+    fast_resume_wakeup();
+    game_mode_wakeup();
+}
+
+void housekeeping_task_user(void) {
+    timer_wheel_task();
+    game_mode_task();
+    boot_profile_task();
+    fast_resume_task();
+    reactive_keys_task();
+    light_stream_task();
+    encoder_accel_task();
+    macro_store_task();
+    usage_stats_task();
+#if defined(CLOCK_GOVERNOR_ENABLE)
+    clock_governor_task();
+#endif
+    rgb_scheduler_task();
+    rgb_driver_task();
+    rgb_driver_yield();
+    matrix_idle_wait();
+}
+
+#if defined(VIA_ENABLE)
+bool via_command_kb(uint8_t *data, uint8_t length) {
+    if (data[0] != PWX_HID_COMMAND_ID) {
         return false;
     }
-    if (!process_socd_cleaner(keycode, record, &socd_h)) {
+    switch (data[1]) {
+        case PWX_HID_USAGE_STATS:
+            usage_stats_hid_command(data, length);
+            break;
+        case PWX_HID_ENCODER:
+            encoder_quadrature_hid_command(data, length);
+            break;
+        case PWX_HID_MACRO_STORE:
+            macro_store_hid_command(data, length);
+            break;
+        case PWX_HID_WEAR_LEVELING:
+            wear_leveling_metrics_hid_command(data, length);
+            break;
+        case PWX_HID_BOOT_PROFILE:
+            boot_profile_hid_command(data, length);
+            break;
+        case PWX_HID_RESUME:
+            fast_resume_hid_command(data, length);
+            break;
+        case PWX_HID_DEBOUNCE:
+            adaptive_debounce_hid_command(data, length);
+            break;
+        case PWX_HID_LED_POWER:
+            rgb_driver_hid_command(data, length);
+            break;
+        case PWX_HID_LIGHT_STREAM:
+            light_stream_hid_command(data, length);
+            break;
+        case PWX_HID_RGB_SCHEDULER:
+            rgb_scheduler_hid_command(data, length);
+            break;
+        case PWX_HID_GAME_MODE:
+            game_mode_hid_command(data, length);
+            break;
+        case PWX_HID_TIMER_WHEEL:
+            timer_wheel_hid_command(data, length);
+            break;
+#    if defined(CLOCK_GOVERNOR_ENABLE)
+        case PWX_HID_CLOCK_GOVERNOR:
+            clock_governor_hid_command(data, length);
+            break;
+#    endif
+#    if defined(SCAN_THREAD_ENABLE)
+        case PWX_HID_SCAN_THREAD:
+            scan_thread_hid_command(data, length);
+            break;
+#    endif
+#    if defined(CYCLE_BENCH_ENABLE)
+        case PWX_HID_CYCLE_BENCH:
+            cycle_bench_hid_command(data, length);
+            break;
+#    endif
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+    raw_hid_send(data, length);
+    return true;
+}
+#endif
+
+#if defined(EVENT_TRACE_ENABLE)
+void socd_cleaner_update_user(uint8_t keycode, bool press) {
+    event_trace(EVENT_TRACE_SOCD, (press ? EVENT_TRACE_SOCD_PRESS : EVENT_TRACE_SOCD_RELEASE) | keycode);
+}
+#endif
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+#if defined(CLOCK_GOVERNOR_ENABLE)
+    clock_governor_demand();
+#endif
+    event_trace(EVENT_TRACE_KEY_EVENT, EVENT_TRACE_KEY_ARG(record->event.key.row, record->event.key.col, record->event.pressed));
+#if defined(EVENT_TRACE_ENABLE)
+    event_trace(EVENT_TRACE_KEY_AGE, MIN(TIMER_DIFF_32(key_time_now_us(), key_time_of(record)), UINT16_MAX));
+#endif
+    game_mode_record(record);
+    bool game = game_mode_active();
+    if (!game) {
+        usage_stats_record(keycode, record);
+        if (record->event.pressed) {
+            reactive_keys_press(record->event.key.row, record->event.key.col);
+        }
+        // Any key press interrupts a snippet that is still being typed.
+        if (record->event.pressed && macro_store_playing()) {
+            macro_store_stop();
+        }
+        if (!process_encoder_accel(keycode, record)) {
+            return false;
+        }
+    }
+    if (!process_socd_cleaner(keycode, record, &socd_v) || !process_socd_cleaner(keycode, record, &socd_h)) {
+        event_trace(EVENT_TRACE_SOCD, EVENT_TRACE_SOCD_SWALLOW | (keycode & 0xFF));
         return false;
     }
-    if (!process_sentence_case(keycode, record)) {
+    if (!game && !process_sentence_case(keycode, record)) {
         return false;
     }
 
@@ -382,22 +630,23 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
                 set_nkro_state(!nkro_enabled, true);
             }
             return false;
+        case GAME_MODE_TOG:
+            if (record->event.pressed) {
+                set_game_mode(!game_mode_active(), true);
+            }
+            return false;
         case DFU_MODE_KEY:
             if (record->event.pressed) {
                 indicators_trigger_dfu_feedback();
-                if (dfu_token != INVALID_DEFERRED_TOKEN) {
-                    cancel_deferred_exec(dfu_token);
-                }
-                dfu_token = defer_exec(500, dfu_deferred_callback, NULL);
+                timer_wheel_cancel(dfu_timer);
+                dfu_timer = timer_wheel_schedule(500, dfu_timer_callback, NULL);
             }
             return false;
         case CLEAR_EEPROM_KEY:
             if (record->event.pressed) {
                 indicators_trigger_eeprom_feedback();
-                if (eeprom_token != INVALID_DEFERRED_TOKEN) {
-                    cancel_deferred_exec(eeprom_token);
-                }
-                eeprom_token = defer_exec(500, eeprom_deferred_callback, NULL);
+                timer_wheel_cancel(eeprom_timer);
+                eeprom_timer = timer_wheel_schedule(500, eeprom_timer_callback, NULL);
             }
             return false;
         case NIGHT_MODE_TOG:
@@ -410,6 +659,11 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
                 night_config_store_current();
             }
             return false;
+        case SNIPPET_1 ... SNIPPET_8:
+            if (record->event.pressed) {
+                macro_store_play(keycode - SNIPPET_1);
+            }
+            return false;
     }
 
     return true;
@@ -1,14 +1,86 @@
 VIA_ENABLE = yes
 ENCODER_MAP_ENABLE = yes
 ENCODER_BUTTONS_ENABLE = yes
-DEFERRED_EXEC_ENABLE = yes
+ENCODER_DRIVER = custom
+CUSTOM_MATRIX = lite
+# Per-key debounce that only slows down keys seen chattering.
+DEBOUNCE_TYPE = custom
 NKRO_ENABLE = yes
 TAP_DANCE_ENABLE = no
 LTO_ENABLE = yes
 LAYER_LOCK_ENABLE = no
 SEND_STRING_ENABLE = no
+# EEPROM wear leveling keeps its spi_flash layout but goes through the
+# keymap's instrumented backing store in utils/wear_leveling_metrics.c.
+WEAR_LEVELING_DRIVER = custom
+FLASH_DRIVER = spi
+# The RGB matrix renders into the keymap's packed frame (utils/rgb_driver.c),
+# which encodes it for the LEDs itself and uses the WS2812 SPI driver only to
+# set up the SPI peripheral.
+RGB_MATRIX_DRIVER = custom
+WS2812_DRIVER_REQUIRED = yes
 SRC += pwx.c
 SRC += utils/indicators.c
 SRC += utils/socd_cleaner.c
-SRC += g_led_config.c
 SRC += utils/sentence_case.c
+SRC += utils/timer_wheel.c
+SRC += utils/usage_stats.c
+SRC += utils/macro_store.c
+SRC += utils/wear_leveling_metrics.c
+SRC += utils/boot_profile.c
+SRC += utils/report_watch.c
+SRC += utils/rgb_driver.c
+SRC += utils/rgb_scheduler.c
+SRC += utils/reactive_keys.c
+SRC += utils/light_stream.c
+SRC += utils/game_mode.c
+SRC += utils/fast_resume.c
+SRC += utils/encoder_accel.c
+SRC += utils/encoder_quadrature.c
+SRC += utils/matrix_scan.c
+SRC += utils/key_time.c
+SRC += utils/adaptive_debounce.c
+SRC += utils/led_layout.c
+
+# LED names and spatial tables are generated from keyboard.json, which also
+# feeds QMK's generated g_led_config. The checked-in output is refreshed
+# whenever keyboard.json or the generator changes.
+LED_LAYOUT_GENERATOR := $(KEYMAP_PATH)/tools/gen_led_layout.py
+$(KEYMAP_PATH)/utils/led_layout.h: $(KEYBOARD_PATH_1)/keyboard.json $(LED_LAYOUT_GENERATOR)
+	python3 $(LED_LAYOUT_GENERATOR) $< $(KEYMAP_PATH)/utils
+$(KEYMAP_PATH)/utils/led_layout.c: $(KEYMAP_PATH)/utils/led_layout.h
+generated-files: $(KEYMAP_PATH)/utils/led_layout.h
+
+# On-target cycle benchmark of the keymap modules, read back over raw HID:
+#   qmk compile -kb rk75 -km pwx -e CYCLE_BENCH_ENABLE=yes
+CYCLE_BENCH_ENABLE ?= no
+ifeq ($(strip $(CYCLE_BENCH_ENABLE)), yes)
+    OPT_DEFS += -DCYCLE_BENCH_ENABLE
+    SRC += utils/cycle_bench.c
+endif
+
+# Drops the core clock while idle; see utils/clock_governor.h:
+#   qmk compile -kb rk75 -km pwx -e CLOCK_GOVERNOR_ENABLE=yes
+CLOCK_GOVERNOR_ENABLE ?= no
+ifeq ($(strip $(CLOCK_GOVERNOR_ENABLE)), yes)
+    OPT_DEFS += -DCLOCK_GOVERNOR_ENABLE
+    SRC += utils/clock_governor.c
+endif
+
+# Streams a binary event trace on UART3; see utils/event_trace.h and
+# tools/trace_decode.py:
+#   qmk compile -kb rk75 -km pwx -e EVENT_TRACE_ENABLE=yes
+EVENT_TRACE_ENABLE ?= no
+ifeq ($(strip $(EVENT_TRACE_ENABLE)), yes)
+    OPT_DEFS += -DEVENT_TRACE_ENABLE
+    SRC += utils/event_trace.c
+endif
+
+# Scans the matrix from a timer-driven thread at a fixed rate; see
+# utils/scan_thread.h:
+#   qmk compile -kb rk75 -km pwx -e SCAN_THREAD_ENABLE=yes
+SCAN_THREAD_ENABLE ?= no
+ifeq ($(strip $(SCAN_THREAD_ENABLE)), yes)
+    OPT_DEFS += -DSCAN_THREAD_ENABLE
+    SRC += utils/scan_thread.c
+endif
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""Catalog the render cost, flash and RAM of every enabled RGB matrix effect.
+
+Cycles come from the keyboard itself: a firmware built with
+CYCLE_BENCH_ENABLE=yes renders each effect on its 80 LEDs and reports the
+cycles of every frame (utils/cycle_bench.h). The same frame pacing, chunking
+and indicator pass apply as in normal use, and one key press per frame gives
+the reactive effects something to draw.
+
+Flash and RAM come from the firmware ELF. Every symbol is attributed to the
+animation header it was defined in, using the debug line information, so
+build it with -e LTO_ENABLE=no: LTO inlines the effects into the renderer and
+their code can no longer be told apart. Two effects from the same header
+(SPLASH and MULTISPLASH, for example) share that header's size. Shared
+effect runners and the buffers that whole families of effects use
+(g_rgb_frame for the framebuffer effects, g_last_hit_tracker for the
+reactive ones) are listed once, with the effects that use them.
+
+Mode numbers and effect names follow QMK's rgb_matrix_effects.inc and the
+animations enabled in keyboard.json, so a QMK checkout is needed to name
+them; without one, effects are listed by mode number.
+
+Usage: effect_catalog.py [--elf FILE] [--qmk DIR] [--no-keyboard] [--json FILE]
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+REPORT_SIZE = 32
+PWX_HID_COMMAND_ID = 0xA0
+PWX_HID_CYCLE_BENCH = 0x03
+OP_INFO, OP_RUN, OP_EFFECT = range(3)
+
+VIA_USAGE_PAGE = 0xFF60
+VIA_USAGE = 0x61
+
+FRAME_BUDGET_MS = 16  # RGB_MATRIX_LED_FLUSH_LIMIT
+SHARED_BUFFERS = ('g_rgb_frame', 'g_last_hit_tracker')
+
+KEYBOARD_JSON = Path(__file__).resolve().parents[3] / 'keyboard.json'
+ANIMATIONS = Path('quantum') / 'rgb_matrix' / 'animations'
+
+
+def load_board(path):
+    with open(path, encoding='utf-8') as f:
+        info = json.load(f)
+    animations = {name for name, enabled in info['rgb_matrix'].get('animations', {}).items() if enabled}
+    return animations, int(info['usb']['vid'], 16), int(info['usb']['pid'], 16)
+
+
+def effect_headers(qmk, animations):
+    """Enabled effects in mode order, as [(NAME, header path)], from mode 1."""
+    directory = Path(qmk) / ANIMATIONS
+    effects = []
+    with open(directory / 'rgb_matrix_effects.inc', encoding='utf-8') as f:
+        includes = re.findall(r'#include\s+"([^"]+)"', f.read())
+    for include in includes:
+        header = directory / include
+        for name in re.findall(r'RGB_MATRIX_EFFECT\((\w+)\)', header.read_text(encoding='utf-8')):
+            if name == 'SOLID_COLOR' or name.lower() in animations:
+                effects.append((name, header))
+    return effects
+
+
+def header_uses(header):
+    text = header.read_text(encoding='utf-8')
+    runners = sorted(set(re.findall(r'\beffect_runner_(\w+)', text)))
+    buffers = [buffer for buffer in SHARED_BUFFERS if buffer in text]
+    return runners, buffers
+
+
+def symbol_sizes(elf, nm):
+    """{source file name: (flash, ram)} and {symbol: size} from nm."""
+    output = subprocess.run([nm, '--print-size', '--line-numbers', '--defined-only', elf],
+                            check=True, capture_output=True, text=True).stdout
+    by_file, by_symbol = {}, {}
+    for line in output.splitlines():
+        fields, _, location = line.partition('\t')
+        fields = fields.split()
+        if len(fields) != 4:
+            continue  # no size
+        size, kind, name = int(fields[1], 16), fields[2].lower(), fields[3]
+        by_symbol[name] = by_symbol.get(name, 0) + size
+        if not location:
+            continue
+        source = Path(location.rsplit(':', 1)[0])
+        flash, ram = by_file.get(source.name, (0, 0))
+        if kind in 'tr':
+            flash += size
+        elif kind == 'd':
+            flash, ram = flash + size, ram + size
+        elif kind == 'b':
+            ram += size
+        by_file[source.name] = (flash, ram)
+    return by_file, by_symbol
+
+
+class Keyboard:
+    def __init__(self, vid, pid):
+        import hid  # hidapi bindings; only needed for a real keyboard
+
+        paths = [d['path'] for d in hid.enumerate(vid, pid) if d['usage_page'] == VIA_USAGE_PAGE and d['usage'] == VIA_USAGE]
+        if not paths:
+            raise SystemExit(f'no raw HID interface for {vid:04x}:{pid:04x}')
+        self.device = hid.device()
+        self.device.open_path(paths[0])
+
+    def request(self, op, body=()):
+        data = bytes([PWX_HID_COMMAND_ID, PWX_HID_CYCLE_BENCH, op]) + bytes(body)
+        self.device.write(b'\0' + data + bytes(REPORT_SIZE - len(data)))
+        while True:
+            reply = bytes(self.device.read(REPORT_SIZE, 3000))
+            if not reply:
+                raise SystemExit('keyboard did not answer; is it built with CYCLE_BENCH_ENABLE=yes?')
+            if reply[0] == PWX_HID_COMMAND_ID and reply[2] == op:
+                if reply[1] != PWX_HID_CYCLE_BENCH:
+                    raise SystemExit('cycle benchmark not available in this firmware')
+                return reply[3:]
+
+    def info(self):
+        reply = self.request(OP_INFO)
+        return int.from_bytes(reply[3:7], 'little'), reply[7], reply[8]
+
+    def effect(self, mode):
+        reply = self.request(OP_EFFECT, [mode])
+        u32 = lambda at: int.from_bytes(reply[at:at + 4], 'little')
+        frames = int.from_bytes(reply[13:15], 'little')
+        return {'min': u32(1), 'max': u32(5), 'mean': u32(9) / frames if frames else 0, 'frames': frames,
+                'chunks': int.from_bytes(reply[15:17], 'little')}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--elf', help='firmware ELF, built with -e LTO_ENABLE=no')
+    parser.add_argument('--nm', default='arm-none-eabi-nm')
+    parser.add_argument('--qmk', default=os.environ.get('QMK_HOME', Path.home() / 'qmk_firmware'), help='QMK checkout')
+    parser.add_argument('--no-keyboard', action='store_true', help='sizes only')
+    parser.add_argument('--hz', type=float, default=96e6, help='cycle counter frequency when not read from the keyboard')
+    parser.add_argument('--cpu-share', type=float, default=0.05, help='CPU share for the suggested frame-rate limit')
+    parser.add_argument('--json', help='also write the catalog to this file')
+    parser.add_argument('--keyboard-json', default=KEYBOARD_JSON)
+    args = parser.parse_args()
+
+    animations, vid, pid = load_board(args.keyboard_json)
+    try:
+        effects = effect_headers(args.qmk, animations)
+    except OSError:
+        print(f'# no QMK checkout at {args.qmk}; effects are listed by mode number', file=sys.stderr)
+        effects = None
+
+    hz, costs = args.hz, {}
+    if not args.no_keyboard:
+        keyboard = Keyboard(vid, pid)
+        hz, effect_max, frames = keyboard.info()
+        if effects is not None and len(effects) != effect_max - 1:
+            print(f'# keyboard has {effect_max - 1} effects, {len(effects)} named; names are not used', file=sys.stderr)
+            effects = None
+        for mode in range(1, effect_max):
+            costs[mode] = keyboard.effect(mode)
+            print(f'# mode {mode}: {costs[mode]["frames"]}/{frames} frames', file=sys.stderr)
+    if effects is None:
+        effects = [(f'mode {mode}', None) for mode in sorted(costs)]
+
+    by_file, by_symbol = symbol_sizes(args.elf, args.nm) if args.elf else ({}, {})
+    if args.elf and not any(header and header.name in by_file for _, header in effects):
+        print('# no symbols from the animation headers; was the ELF built with LTO?', file=sys.stderr)
+
+    catalog = []
+    for mode, (name, header) in enumerate(effects, 1):
+        runners, buffers = header_uses(header) if header else ([], [])
+        flash, ram = by_file.get(header.name, (None, None)) if header and by_file else (None, None)
+        entry = {'mode': mode, 'name': name, 'header': header.name if header else None, 'flash': flash, 'ram': ram,
+                 'runners': runners, 'buffers': buffers}
+        cost = costs.get(mode)
+        if cost:
+            us = cost['mean'] / hz * 1e6
+            entry.update(cost, us=us, frame_share=us / (FRAME_BUDGET_MS * 1000),
+                         fps_limit=args.cpu_share * 1e6 / us if us else None)
+        catalog.append(entry)
+
+    print(f'{"mode":>4}  {"effect":28} {"cycles/frame":>12} {"max":>9} {"us":>7} {"chunks":>6} '
+          f'{"fps@" + format(args.cpu_share, ".0%"):>8} {"flash":>6} {"ram":>5}  shared')
+    for entry in sorted(catalog, key=lambda entry: -entry.get('mean', 0)):
+        shared = ', '.join(entry['runners'] + entry['buffers'])
+        cost = f'{entry["mean"]:12.0f} {entry["max"]:9} {entry["us"]:7.1f} {entry["chunks"]:6}' if 'mean' in entry else f'{"-":>12} {"-":>9} {"-":>7} {"-":>6}'
+        fps = f'{entry["fps_limit"]:8.0f}' if entry.get('fps_limit') else f'{"-":>8}'
+        size = lambda value, width: f'{"-" if value is None else value:>{width}}'
+        print(f'{entry["mode"]:4}  {entry["name"]:28} {cost} {fps} {size(entry["flash"], 6)} {size(entry["ram"], 5)}  {shared}')
+
+    if by_symbol or by_file:
+        used_runners = sorted({runner for entry in catalog for runner in entry['runners']})
+        print('shared:')
+        for runner in used_runners:
+            flash, _ = by_file.get(f'effect_runner_{runner}.h', (None, None))
+            users = [entry['name'] for entry in catalog if runner in entry['runners']]
+            print(f'  effect_runner_{runner:16} flash {flash if flash is not None else "-":>6}  {", ".join(users)}')
+        for buffer in SHARED_BUFFERS:
+            users = [entry['name'] for entry in catalog if buffer in entry['buffers']]
+            if users:
+                print(f'  {buffer:30} ram {by_symbol.get(buffer, "-"):>8}  {", ".join(users)}')
+
+    if args.json:
+        with open(args.json, 'w', encoding='utf-8') as f:
+            json.dump({'counter_hz': hz, 'effects': catalog}, f, indent=2, default=str)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Generate LED constants and spatial lookup tables from keyboard.json.
+
+keyboard.json (rgb_matrix.layout) is the single source of truth for the LED
+layout: QMK builds g_led_config from it, and this script derives everything
+the keymap needs on top of that:
+
+  led_layout.h  LED_Rx_Cy names for every keyed LED, LED_KEY_ROW/COL helpers
+  led_layout.c  matrix -> LED and LED -> matrix tables, nearest neighbours in
+                each direction and the LED-to-LED distance table
+
+Usage: gen_led_layout.py <keyboard.json> <output directory>
+"""
+
+import json
+import math
+import sys
+from pathlib import Path
+
+NO_LED = 255
+DIRECTIONS = ('LEFT', 'RIGHT', 'UP', 'DOWN')
+
+
+def load_layout(path):
+    with open(path, encoding='utf-8') as f:
+        info = json.load(f)
+    layout = info['rgb_matrix']['layout']
+    rows = len(info['matrix_pins']['rows'])
+    cols = len(info['matrix_pins']['cols'])
+    return layout, rows, cols
+
+
+def distance(a, b):
+    # Same integer metric as the splash effects: sqrt16(dx * dx + dy * dy).
+    dx = a['x'] - b['x']
+    dy = a['y'] - b['y']
+    return min(math.isqrt(dx * dx + dy * dy), 255)
+
+
+def neighbour(layout, index, direction):
+    """Closest LED in a direction, preferring the same row or column."""
+    me = layout[index]
+    best, best_key = NO_LED, None
+    for other, led in enumerate(layout):
+        if other == index:
+            continue
+        dx = led['x'] - me['x']
+        dy = led['y'] - me['y']
+        if direction == 'LEFT':
+            along, across = -dx, abs(dy)
+        elif direction == 'RIGHT':
+            along, across = dx, abs(dy)
+        elif direction == 'UP':
+            along, across = -dy, abs(dx)
+        else:
+            along, across = dy, abs(dx)
+        if along <= 0 or across > along:
+            continue
+        key = (across, along)
+        if best_key is None or key < best_key:
+            best, best_key = other, key
+    return best
+
+
+def format_rows(values, per_line=16, indent='    '):
+    lines = []
+    for start in range(0, len(values), per_line):
+        chunk = values[start:start + per_line]
+        lines.append(indent + ', '.join(f'{v:3d}' for v in chunk) + ',')
+    return '\n'.join(lines)
+
+
+def write_header(path, layout, rows, cols):
+    names = []
+    for index, led in enumerate(layout):
+        if 'matrix' in led:
+            row, col = led['matrix']
+            names.append(f'#define LED_R{row}_C{col} {index}')
+    text = f'''// Generated by tools/gen_led_layout.py from keyboard.json. Do not edit.
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#define LED_LAYOUT_COUNT {len(layout)}
+#define LED_LAYOUT_ROWS {rows}
+#define LED_LAYOUT_COLS {cols}
+
+// LED index of the key at matrix position [row, col].
+{chr(10).join(names)}
+
+// LED of each matrix position, NO_LED where the switch has none.
+extern const uint8_t matrix_to_led[LED_LAYOUT_ROWS][LED_LAYOUT_COLS];
+
+// Packed (row << 4) | col of each LED; LED_NO_KEY when it has no switch.
+#define LED_NO_KEY 0xFF
+#define LED_KEY_ROW(packed) ((packed) >> 4)
+#define LED_KEY_COL(packed) ((packed) & 0x0F)
+extern const uint8_t led_to_matrix[LED_LAYOUT_COUNT];
+
+// Nearest LED in each direction, NO_LED at the edge of the board.
+typedef enum {{
+    LED_NEIGHBOR_LEFT = 0,
+    LED_NEIGHBOR_RIGHT,
+    LED_NEIGHBOR_UP,
+    LED_NEIGHBOR_DOWN,
+    LED_NEIGHBOR_COUNT,
+}} led_neighbor_t;
+extern const uint8_t led_neighbors[LED_LAYOUT_COUNT][LED_NEIGHBOR_COUNT];
+
+// Integer distance between two LEDs in g_led_config units, as used by the
+// splash and reactive effects.
+extern const uint8_t led_distance[LED_LAYOUT_COUNT][LED_LAYOUT_COUNT];
+'''
+    path.write_text(text, encoding='utf-8')
+
+
+def write_source(path, layout, rows, cols):
+    keyed = [[NO_LED] * cols for _ in range(rows)]
+    packed = []
+    for led in layout:
+        if 'matrix' in led:
+            row, col = led['matrix']
+            keyed[row][col] = len(packed)
+            packed.append((row << 4) | col)
+        else:
+            packed.append(NO_LED)
+    neighbours = []
+    for i in range(len(layout)):
+        entries = ', '.join(f'{neighbour(layout, i, d):3d}' for d in DIRECTIONS)
+        neighbours.append(f'    {{{entries}}},')
+    distances = [distance(a, b) for a in layout for b in layout]
+
+    rows = []
+    for i in range(len(layout)):
+        rows.append('    {\n' + format_rows(distances[i * len(layout):(i + 1) * len(layout)], indent='        ') + '\n    },')
+
+    matrix = '\n'.join('    {' + ', '.join(f'{v:3d}' for v in row) + '},' for row in keyed)
+
+    text = f'''// Generated by tools/gen_led_layout.py from keyboard.json. Do not edit.
+#include "led_layout.h"
+
+const uint8_t matrix_to_led[LED_LAYOUT_ROWS][LED_LAYOUT_COLS] = {{
+{matrix}
+}};
+
+const uint8_t led_to_matrix[LED_LAYOUT_COUNT] = {{
+{format_rows(packed)}
+}};
+
+const uint8_t led_neighbors[LED_LAYOUT_COUNT][LED_NEIGHBOR_COUNT] = {{
+{chr(10).join(neighbours)}
+}};
+
+const uint8_t led_distance[LED_LAYOUT_COUNT][LED_LAYOUT_COUNT] = {{
+{chr(10).join(rows)}
+}};
+'''
+    path.write_text(text, encoding='utf-8')
+
+
+def main(argv):
+    if len(argv) != 3:
+        print(__doc__.strip().splitlines()[-1], file=sys.stderr)
+        return 2
+    layout, rows, cols = load_layout(argv[1])
+    if cols > 16 or rows > 16:
+        print('matrix too large for packed LED keys', file=sys.stderr)
+        return 1
+    out = Path(argv[2])
+    write_header(out / 'led_layout.h', layout, rows, cols)
+    write_source(out / 'led_layout.c', layout, rows, cols)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
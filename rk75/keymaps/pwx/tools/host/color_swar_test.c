@@ -0,0 +1,289 @@
+#include "color_swar.h"
+#include "ws2812_encode.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Checks every packed-pixel kernel against the per-channel integer math it
+// replaced, over every input value of each channel with the other channels
+// of the pixel moving as well, so a carry or borrow between lanes shows up.
+// The WS2812 encoder is checked against QMK's ws2812_spi encoding. Then
+// times both versions over a frame of the board's LEDs; the numbers are for
+// the host CPU and only compare the two, the keyboard's are read with
+// CYCLE_BENCH_ENABLE.
+
+#define LEDS 80
+#define BENCH_FRAMES 200000
+
+static uint8_t clamp(uint32_t x) {
+    return x > 0xFF ? 0xFF : x;
+}
+
+// The indicator's per-channel HSV conversion before it moved to color_swar.h.
+static rgb_pixel_t ref_from_hsv(uint8_t h, uint8_t s, uint8_t v) {
+    if (s == 0 || v == 0) {
+        return RGB_PIXEL(v, v, v);
+    }
+    uint8_t  region    = h / 43;
+    uint16_t remainder = (h - (region * 43)) * 6;
+    uint8_t  p         = (uint16_t)v * (255 - s) / 255;
+    uint8_t  q         = (uint16_t)v * (255 - ((uint16_t)s * remainder / 255)) / 255;
+    uint8_t  t         = (uint16_t)v * (255 - ((uint16_t)s * (255 - remainder) / 255)) / 255;
+    switch (region) {
+        case 0:
+            return RGB_PIXEL(v, t, p);
+        case 1:
+            return RGB_PIXEL(q, v, p);
+        case 2:
+            return RGB_PIXEL(p, v, t);
+        case 3:
+            return RGB_PIXEL(p, q, v);
+        case 4:
+            return RGB_PIXEL(t, p, v);
+        default:
+            return RGB_PIXEL(v, p, q);
+    }
+}
+
+static rgb_pixel_t ref_scale_shift(rgb_pixel_t px, uint8_t factor, uint8_t shift) {
+    return RGB_PIXEL(clamp((rgb_pixel_r(px) * factor) >> shift), clamp((rgb_pixel_g(px) * factor) >> shift), clamp((rgb_pixel_b(px) * factor) >> shift));
+}
+
+static rgb_pixel_t ref_add_saturate(rgb_pixel_t a, rgb_pixel_t b) {
+    return RGB_PIXEL(clamp(rgb_pixel_r(a) + rgb_pixel_r(b)), clamp(rgb_pixel_g(a) + rgb_pixel_g(b)), clamp(rgb_pixel_b(a) + rgb_pixel_b(b)));
+}
+
+static uint8_t ref_lerp8(uint8_t a, uint8_t b, uint16_t t) {
+    return (a * (256 - t) + b * t) >> 8;
+}
+
+static rgb_pixel_t ref_lerp(rgb_pixel_t a, rgb_pixel_t b, uint16_t t) {
+    return RGB_PIXEL(ref_lerp8(rgb_pixel_r(a), rgb_pixel_r(b), t), ref_lerp8(rgb_pixel_g(a), rgb_pixel_g(b), t), ref_lerp8(rgb_pixel_b(a), rgb_pixel_b(b), t));
+}
+
+// QMK ws2812_spi's get_protocol_eq(): SPI byte `pos` of a colour byte.
+static uint8_t ref_protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = data & (1 << (2 * (3 - pos))) ? 0b1110 : 0b1000;
+    return eq + (data & (2 << (2 * (3 - pos))) ? 0b11100000 : 0b10000000);
+}
+
+// QMK's set_led_color_rgb() for the default GRB order, into a byte frame.
+static void ref_encode_pixel(uint8_t *frame, uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t *out = &frame[4 * WS2812_SPI_PREAMBLE_WORDS + 12 * index];
+    for (int j = 0; j < 4; j++) {
+        out[j]     = ref_protocol_eq(g, j);
+        out[4 + j] = ref_protocol_eq(r, j);
+        out[8 + j] = ref_protocol_eq(b, j);
+    }
+}
+
+static bool report(const char *name, uint64_t checked, uint64_t wrong) {
+    printf("%-26s %12llu %8llu  %s\n", name, (unsigned long long)checked, (unsigned long long)wrong, wrong ? "FAIL" : "ok");
+    return wrong == 0;
+}
+
+static bool check_div255(void) {
+    uint64_t checked = 0, wrong = 0;
+    for (uint32_t x = 0; x <= 255 * 255; x++) {
+        uint32_t y     = 255 * 255 - x;
+        uint32_t lanes = swar_div255(x | (y << 16));
+        wrong += (lanes & 0xFFFF) != x / 255 || lanes >> 16 != y / 255;
+        checked++;
+    }
+    return report("swar_div255", checked, wrong);
+}
+
+static bool check_scale_shift(void) {
+    uint64_t checked = 0, wrong = 0;
+    for (uint32_t shift = 0; shift <= 8; shift++) {
+        for (uint32_t factor = 0; factor <= 0xFF; factor++) {
+            for (uint32_t c = 0; c <= 0xFF; c++) {
+                rgb_pixel_t px = RGB_PIXEL(c, 0xFF - c, c ^ 0xA5);
+                wrong += rgb_pixel_scale_shift(px, factor, shift) != ref_scale_shift(px, factor, shift);
+                checked++;
+            }
+        }
+    }
+    return report("rgb_pixel_scale_shift", checked, wrong);
+}
+
+static bool check_scale_div(void) {
+    uint64_t checked = 0, wrong = 0;
+    for (uint32_t divisor = 1; divisor <= 0xFF; divisor++) {
+        for (uint32_t factor = 0; factor <= 0xFF; factor++) {
+            for (uint32_t c = 0; c <= 0xFF; c++) {
+                rgb_pixel_t px  = RGB_PIXEL(c, 0xFF - c, c ^ 0xA5);
+                rgb_pixel_t ref = RGB_PIXEL(clamp(rgb_pixel_r(px) * factor / divisor), clamp(rgb_pixel_g(px) * factor / divisor), clamp(rgb_pixel_b(px) * factor / divisor));
+                wrong += rgb_pixel_scale_div(px, factor, divisor) != ref;
+                checked++;
+            }
+        }
+    }
+    return report("rgb_pixel_scale_div", checked, wrong);
+}
+
+static bool check_add_saturate(void) {
+    uint64_t checked = 0, wrong = 0;
+    for (uint32_t x = 0; x <= 0xFF; x++) {
+        for (uint32_t y = 0; y <= 0xFF; y++) {
+            rgb_pixel_t a = RGB_PIXEL(x, 0xFF - x, x);
+            rgb_pixel_t b = RGB_PIXEL(y, y, 0xFF - y);
+            wrong += rgb_pixel_add_saturate(a, b) != ref_add_saturate(a, b);
+            checked++;
+        }
+    }
+    return report("rgb_pixel_add_saturate", checked, wrong);
+}
+
+static bool check_lerp(void) {
+    uint64_t checked = 0, wrong = 0;
+    for (uint32_t t = 0; t <= 256; t++) {
+        for (uint32_t x = 0; x <= 0xFF; x++) {
+            for (uint32_t y = 0; y <= 0xFF; y++) {
+                rgb_pixel_t a = RGB_PIXEL(x, 0xFF - x, x);
+                rgb_pixel_t b = RGB_PIXEL(y, y, 0xFF - y);
+                wrong += rgb_pixel_lerp(a, b, t) != ref_lerp(a, b, t);
+                checked++;
+            }
+        }
+        // t = 256 must land on b exactly.
+        wrong += t == 256 && rgb_pixel_lerp(0x123456, 0xFEDCBA, t) != 0xFEDCBA;
+    }
+    return report("rgb_pixel_lerp", checked, wrong);
+}
+
+static bool check_from_hsv(void) {
+    uint64_t checked = 0, wrong = 0;
+    for (uint32_t h = 0; h <= 0xFF; h++) {
+        for (uint32_t s = 0; s <= 0xFF; s++) {
+            for (uint32_t v = 0; v <= 0xFF; v++) {
+                wrong += rgb_pixel_from_hsv(h, s, v) != ref_from_hsv(h, s, v);
+                checked++;
+            }
+        }
+    }
+    return report("rgb_pixel_from_hsv", checked, wrong);
+}
+
+static bool check_ws2812_encode(void) {
+    uint64_t checked = 0, wrong = 0;
+    uint32_t frame[WS2812_SPI_FRAME_WORDS(LEDS)] = {0};
+    uint8_t  ref[sizeof(frame)]                  = {0};
+    for (uint32_t c = 0; c <= 0xFF; c++) {
+        for (uint8_t led = 0; led < LEDS; led++) {
+            uint8_t r = c, g = c + led * 3, b = 0xFF - c + led;
+            ws2812_encode_pixel(frame, led, RGB_PIXEL(r, g, b));
+            ref_encode_pixel(ref, led, r, g, b);
+        }
+        wrong += memcmp(frame, ref, sizeof(frame)) != 0;
+        checked++;
+    }
+    return report("ws2812_encode_pixel", checked, wrong);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static rgb_pixel_t frame_a[LEDS], frame_b[LEDS], frame_out[LEDS];
+static uint32_t    spi_frame[WS2812_SPI_FRAME_WORDS(LEDS)];
+static uint8_t     spi_ref[sizeof(spi_frame)];
+
+// Results are read back, or the compiler drops stores nothing reads.
+static volatile uint32_t sink;
+
+// Each pass gets its own t so the compiler cannot hoist the work out of the
+// timing loop.
+__attribute__((noipa)) static void lerp_swar(uint16_t t) {
+    for (uint8_t i = 0; i < LEDS; i++) {
+        frame_out[i] = rgb_pixel_lerp(frame_a[i], frame_b[i], t);
+    }
+}
+
+__attribute__((noipa)) static void lerp_scalar(uint16_t t) {
+    for (uint8_t i = 0; i < LEDS; i++) {
+        frame_out[i] = ref_lerp(frame_a[i], frame_b[i], t);
+    }
+}
+
+__attribute__((noipa)) static void scale_swar(uint16_t t) {
+    for (uint8_t i = 0; i < LEDS; i++) {
+        frame_out[i] = rgb_pixel_scale_shift(frame_a[i], t, 7);
+    }
+}
+
+__attribute__((noipa)) static void scale_scalar(uint16_t t) {
+    for (uint8_t i = 0; i < LEDS; i++) {
+        frame_out[i] = ref_scale_shift(frame_a[i], t, 7);
+    }
+}
+
+__attribute__((noipa)) static void hsv_swar(uint16_t t) {
+    for (uint8_t i = 0; i < LEDS; i++) {
+        frame_out[i] = rgb_pixel_from_hsv(t + i, 0xFF - i, 0x80 + i);
+    }
+}
+
+__attribute__((noipa)) static void hsv_scalar(uint16_t t) {
+    for (uint8_t i = 0; i < LEDS; i++) {
+        frame_out[i] = ref_from_hsv(t + i, 0xFF - i, 0x80 + i);
+    }
+}
+
+__attribute__((noipa)) static void encode_table(uint16_t t) {
+    for (uint8_t i = 0; i < LEDS; i++) {
+        ws2812_encode_pixel(spi_frame, i, frame_a[i] + t);
+    }
+}
+
+__attribute__((noipa)) static void encode_bitwise(uint16_t t) {
+    for (uint8_t i = 0; i < LEDS; i++) {
+        rgb_pixel_t px = frame_a[i] + t;
+        ref_encode_pixel(spi_ref, i, rgb_pixel_r(px), rgb_pixel_g(px), rgb_pixel_b(px));
+    }
+}
+
+static double bench(void (*pass)(uint16_t)) {
+    double start = now_ns();
+    for (uint32_t n = 0; n < BENCH_FRAMES; n++) {
+        pass(n & 0xFF);
+    }
+    double ns = (now_ns() - start) / BENCH_FRAMES / LEDS;
+    for (uint8_t i = 0; i < LEDS; i++) {
+        sink += frame_out[i] + spi_frame[i] + spi_ref[i];
+    }
+    return ns;
+}
+
+static void compare(const char *name, void (*swar)(uint16_t), void (*scalar)(uint16_t)) {
+    double fast = bench(swar);
+    double slow = bench(scalar);
+    printf("%-26s %9.2f %9.2f %7.2fx\n", name, fast, slow, slow / fast);
+}
+
+int main(void) {
+    bool ok = true;
+    printf("%-26s %12s %8s\n", "kernel", "checked", "wrong");
+    ok &= check_div255();
+    ok &= check_scale_shift();
+    ok &= check_scale_div();
+    ok &= check_add_saturate();
+    ok &= check_lerp();
+    ok &= check_from_hsv();
+    ok &= check_ws2812_encode();
+
+    for (uint8_t i = 0; i < LEDS; i++) {
+        frame_a[i] = ref_from_hsv(i * 3, 0xFF, 0xFF);
+        frame_b[i] = ref_from_hsv(0xFF - i * 3, 0xC0, 0x80);
+    }
+    printf("\n%-26s %9s %9s %8s\n", "ns per pixel (host)", "packed", "channel", "speedup");
+    compare("lerp", lerp_swar, lerp_scalar);
+    compare("scale_shift", scale_swar, scale_scalar);
+    compare("from_hsv", hsv_swar, hsv_scalar);
+    compare("ws2812 encode", encode_table, encode_bitwise);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+#include "encoder_accel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "encoder.h"
+
+// Replays quadrature pulse trains on the encoder pins. Edges go through the
+// interrupt decoder (utils/encoder_quadrature.c), detents through
+// encoder_map and encoder_accel.c, as in process_record_user(), and the taps
+// that come out are checked against what each spin should give.
+
+void encoder_driver_init(void);
+void encoder_driver_task(void);
+
+#define PASS_US 250
+#define DIRECTION_CW 1
+#define DIRECTION_CCW -1
+
+static const pin_t pins_a[] = ENCODER_A_PINS;
+static const pin_t pins_b[] = ENCODER_B_PINS;
+
+// Layers 0-2 of the keymap's encoder_map.
+static const uint16_t encoder_map[][2] = {
+    {KC_VOLD, KC_VOLU},
+    {KC_F19, KC_F20},
+    {KC_F22, KC_F23},
+};
+
+static struct {
+    bool     queued;
+    bool     clockwise;
+    uint32_t detents;
+} queue;
+
+bool encoder_queue_full(void) {
+    return queue.queued;
+}
+
+void encoder_queue_event(uint8_t index, bool clockwise) {
+    queue.queued    = true;
+    queue.clockwise = clockwise;
+    queue.detents++;
+}
+
+static struct {
+    int32_t  increments; // signed by direction, counted on press
+    uint32_t changes;    // report changes
+    uint32_t wrong_key;
+    uint32_t reversals;  // presses after the first one the other way
+    uint16_t cw, ccw;
+    uint64_t first_change_us;
+    uint64_t last_change_us;
+    uint64_t min_gap_us;
+    bool     turned_back;
+} taps;
+
+static void code_sink(uint16_t code, bool pressed) {
+    uint64_t now = host_now_us();
+    if (taps.changes && now - taps.last_change_us < taps.min_gap_us) {
+        taps.min_gap_us = now - taps.last_change_us;
+    }
+    if (!taps.changes) {
+        taps.first_change_us = now;
+    }
+    taps.last_change_us = now;
+    taps.changes++;
+    if (!pressed) {
+        return;
+    }
+    if (code == taps.cw) {
+        taps.increments++;
+        taps.reversals += taps.turned_back;
+    } else if (code == taps.ccw) {
+        taps.increments--;
+        taps.turned_back = true;
+    } else {
+        taps.wrong_key++;
+    }
+}
+
+// One main loop pass: the encoder task, the event through encoder_map as a
+// press and a release, then the keymap's housekeeping.
+static void main_loop_pass(void) {
+    encoder_driver_task();
+    if (queue.queued) {
+        queue.queued       = false;
+        uint8_t     layer  = get_highest_layer(layer_state | default_layer_state);
+        uint16_t    code   = encoder_map[layer][queue.clockwise];
+        keyrecord_t record = {.event = {.key = {.col = 0}, .type = queue.clockwise ? ENCODER_CW_EVENT : ENCODER_CCW_EVENT, .time = timer_read(), .pressed = true}};
+        process_encoder_accel(code, &record);
+        record.event.pressed = false;
+        process_encoder_accel(code, &record);
+    }
+    encoder_accel_task();
+}
+
+static void run_until(uint64_t until_us) {
+    while (host_now_us() < until_us) {
+        main_loop_pass();
+        host_advance_us(PASS_US);
+    }
+}
+
+// One detent: a full quadrature cycle back to both lines high, its four edges
+// spread over period_us. `bounce` adds contact chatter on every edge.
+static void detent(int direction, uint32_t period_us, bool bounce) {
+    static const uint8_t cw[4]  = {0x2, 0x0, 0x1, 0x3}; // B:A
+    static const uint8_t ccw[4] = {0x1, 0x0, 0x2, 0x3};
+    const uint8_t       *steps  = direction == DIRECTION_CW ? cw : ccw;
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t previous = i ? steps[i - 1] : 0x3;
+        pin_t   changed  = ((steps[i] ^ previous) & 1) ? pins_a[0] : pins_b[0];
+        bool    level    = ((steps[i] ^ previous) & 1) ? steps[i] & 1 : steps[i] >> 1;
+        if (bounce) {
+            host_gpio_write(changed, level);
+            host_gpio_write(changed, !level);
+            host_advance_us(20);
+        }
+        host_gpio_write(changed, level);
+        run_until(host_now_us() + period_us / 4);
+    }
+}
+
+static void begin(uint8_t layer) {
+    memset(&taps, 0, sizeof(taps));
+    taps.min_gap_us = UINT64_MAX;
+    layer_state     = layer ? 1UL << layer : 0;
+    taps.cw  = encoder_map[layer][1];
+    taps.ccw = encoder_map[layer][0];
+    queue.detents = 0;
+}
+
+// Lets every queued tap go out, then reports how long that took.
+static uint32_t settle(void) {
+    uint64_t start = host_now_us();
+    run_until(start + 1000000);
+    return taps.changes && taps.last_change_us > start ? (taps.last_change_us - start) / 1000 : 0;
+}
+
+static bool check(const char *name, bool ok, int32_t increments, uint32_t tail_ms) {
+    printf("%-34s %7u %10d %7u %8u %7.1f  %s\n", name, queue.detents, increments, taps.changes, tail_ms, taps.changes > 1 ? taps.min_gap_us / 1000.0 : 0, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+int main(void) {
+    bool ok = true;
+
+    host_code_sink = code_sink;
+    encoder_driver_init();
+    printf("%-34s %7s %10s %7s %8s %7s\n", "spin", "detents", "increments", "reports", "tail_ms", "gap_ms");
+
+    // Slow: one increment per detent.
+    begin(0);
+    for (int i = 0; i < 10; i++) {
+        detent(DIRECTION_CW, 150000, false);
+    }
+    uint32_t tail = settle();
+    ok &= check("slow, 10 detents cw", taps.increments == 10 && taps.changes == 20, taps.increments, tail);
+
+    // Fast: scaled up to ENCODER_ACCEL_FAST_STEPS per detent, paced, and
+    // finished shortly after the hand stops.
+    begin(0);
+    for (int i = 0; i < 24; i++) {
+        detent(DIRECTION_CCW, 12000, false);
+    }
+    tail = settle();
+    ok &= check("fast, 24 detents ccw", taps.increments < -24 && taps.increments >= -24 * ENCODER_ACCEL_FAST_STEPS && taps.min_gap_us >= ENCODER_ACCEL_REPORT_MS * 1000 - 1000 && tail <= ENCODER_ACCEL_MAX_PENDING * 2 * ENCODER_ACCEL_REPORT_MS + ENCODER_ACCEL_BURST_MS, taps.increments, tail);
+
+    // A burst closes ENCODER_ACCEL_BURST_MS after its first detent, not after
+    // a gap, so a steady spin is heard while it lasts.
+    begin(0);
+    uint64_t spin_start = host_now_us();
+    for (int i = 0; i < 24; i++) {
+        detent(DIRECTION_CW, 12000, false);
+    }
+    uint64_t spin_end = host_now_us();
+    tail              = settle();
+    ok &= check("steady spin, sent while turning", taps.changes && taps.first_change_us <= spin_start + 12000 + ENCODER_ACCEL_BURST_MS * 1000 + PASS_US && taps.first_change_us < spin_end, taps.increments, tail);
+
+    // Wobble inside one burst cancels before anything is sent.
+    begin(0);
+    detent(DIRECTION_CW, 4000, false);
+    detent(DIRECTION_CCW, 4000, false);
+    detent(DIRECTION_CW, 4000, false);
+    detent(DIRECTION_CCW, 4000, false);
+    tail = settle();
+    ok &= check("wobble, 4 detents in one burst", taps.increments == 0 && taps.changes == 0, taps.increments, tail);
+
+    // Turning back drops what is left of the previous step.
+    begin(0);
+    for (int i = 0; i < 12; i++) {
+        detent(DIRECTION_CW, 10000, false);
+    }
+    run_until(host_now_us() + 300000);
+    for (int i = 0; i < 3; i++) {
+        detent(DIRECTION_CCW, 150000, false);
+    }
+    tail = settle();
+    ok &= check("fast cw, then slow ccw", taps.reversals == 0 && taps.turned_back, taps.increments, tail);
+
+    // Contact chatter on every edge still gives one detent per cycle.
+    begin(0);
+    for (int i = 0; i < 10; i++) {
+        detent(DIRECTION_CW, 150000, true);
+    }
+    tail = settle();
+    ok &= check("slow with chatter, 10 detents cw", queue.detents == 10 && taps.increments == 10, taps.increments, tail);
+
+    // Layers 1 and 2 send their F-keys the same way.
+    for (uint8_t layer = 1; layer <= 2; layer++) {
+        begin(layer);
+        for (int i = 0; i < 5; i++) {
+            detent(DIRECTION_CW, 150000, false);
+        }
+        for (int i = 0; i < 5; i++) {
+            detent(DIRECTION_CCW, 150000, false);
+        }
+        tail = settle();
+        char name[40];
+        snprintf(name, sizeof(name), "layer %u, 5 cw then 5 ccw", layer);
+        ok &= check(name, taps.increments == 0 && taps.changes == 20 && taps.wrong_key == 0, taps.increments, tail);
+    }
+
+    return ok ? 0 : 1;
+}
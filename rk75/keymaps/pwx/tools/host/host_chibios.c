@@ -0,0 +1,144 @@
+#include "ch.h"
+#include "hal.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+// Cooperative stand-in for the kernel (see include/ch.h): the created thread
+// has its own context and is switched to only where the main thread would
+// let it run on the board.
+
+#define THREAD_STACK (64 * 1024)
+#define TICK_US (1000000UL / CH_CFG_ST_FREQUENCY)
+
+static ucontext_t main_context;
+static ucontext_t thread_context;
+static thread_t   thread;
+static bool       created   = false;
+static bool       in_thread = false;
+static tprio_t    main_prio = NORMALPRIO;
+static tfunc_t    thread_func;
+static void      *thread_arg;
+
+static binary_semaphore_t *waiting_on;
+
+static void thread_entry(void) {
+    thread_func(thread_arg);
+    abort(); // threads here never return
+}
+
+// Runs the thread until it blocks again, if it is ready.
+static void run_thread(void) {
+    if (created && !in_thread && thread.state == CH_STATE_READY) {
+        in_thread = true;
+        swapcontext(&main_context, &thread_context);
+        in_thread = false;
+    }
+}
+
+thread_t *chThdCreateStatic(void *wa, size_t size, tprio_t prio, tfunc_t func, void *arg) {
+    assert(!created && prio < main_prio);
+    getcontext(&thread_context);
+    thread_context.uc_stack.ss_sp   = malloc(THREAD_STACK);
+    thread_context.uc_stack.ss_size = THREAD_STACK;
+    thread_context.uc_link          = NULL;
+    makecontext(&thread_context, thread_entry, 0);
+    thread_func  = func;
+    thread_arg   = arg;
+    thread.state = CH_STATE_READY;
+    thread.prio  = prio;
+    created      = true;
+    return &thread;
+}
+
+tprio_t chThdSetPriority(tprio_t prio) {
+    tprio_t old = main_prio;
+    main_prio   = prio;
+    if (created && thread.prio > main_prio) {
+        run_thread();
+    }
+    return old;
+}
+
+void host_chibios_sleep_until(uint64_t at_us) {
+    assert(!in_thread);
+    run_thread();
+    while (host_now_us() < at_us) {
+        // Each step ends where the thread may have become ready.
+        host_advance_us(1);
+        run_thread();
+    }
+}
+
+void chThdSleep(sysinterval_t ticks) {
+    host_chibios_sleep_until(host_now_us() + ticks * TICK_US);
+}
+
+void chRegSetThreadName(const char *name) {}
+
+void host_chibios_block(tstate_t state) {
+    assert(in_thread);
+    thread.state = state;
+    swapcontext(&thread_context, &main_context);
+}
+
+void host_chibios_wake(void) {
+    thread.state = CH_STATE_READY;
+}
+
+void chBSemObjectInit(binary_semaphore_t *bsp, bool taken) {
+    bsp->taken = taken;
+}
+
+msg_t chBSemWait(binary_semaphore_t *bsp) {
+    if (!bsp->taken) {
+        bsp->taken = true;
+        return MSG_OK;
+    }
+    waiting_on = bsp;
+    host_chibios_block(CH_STATE_WTSEM);
+    return MSG_OK;
+}
+
+// Passes a signal straight to a waiting thread; the semaphore stays taken.
+void chBSemSignalI(binary_semaphore_t *bsp) {
+    if (waiting_on == bsp && thread.state == CH_STATE_WTSEM) {
+        waiting_on = NULL;
+        host_chibios_wake();
+    } else {
+        bsp->taken = false;
+    }
+}
+
+// WS2812 SPI clock: the core clock through WS2812_SPI_DIVISOR.
+#ifndef WS2812_SPI_DIVISOR
+#    define WS2812_SPI_DIVISOR 32
+#endif
+
+SPIDriver SPIDM2;
+uint32_t  host_spi_hz       = HOST_CORE_HZ / WS2812_SPI_DIVISOR;
+uint32_t  host_spi_setup_us = 0;
+
+void (*host_spi_sink)(const void *txbuf, size_t n, uint64_t end_us);
+
+static SPIDriver *transferring;
+
+static void spi_dma_end(void) {
+    transferring->busy = false;
+    transferring       = NULL;
+    host_chibios_wake();
+}
+
+void spiSend(SPIDriver *spip, size_t n, const void *txbuf) {
+    assert(in_thread && !spip->busy);
+    host_advance_us(host_spi_setup_us);
+    uint64_t end = host_now_us() + ((uint64_t)n * 8 * 1000000 + host_spi_hz - 1) / host_spi_hz;
+    if (host_spi_sink) {
+        host_spi_sink(txbuf, n, end);
+    }
+    spip->busy   = true;
+    transferring = spip;
+    host_alarm(end, spi_dma_end);
+    host_chibios_block(CH_STATE_SUSPENDED);
+}
@@ -0,0 +1,289 @@
+#include "qmk_host.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The parts of QMK the keymap modules call into, reduced to what a host
+// test needs: one simulated clock, a NOR flash and a keyboard report.
+
+static uint64_t now_us;
+static uint64_t alarm_at;
+static void (*alarm_isr)(void);
+
+CoreDebug_Type host_core_debug;
+DWT_Type       host_dwt;
+
+static void set_clock(uint64_t us) {
+    host_dwt.CYCCNT += (uint32_t)(us - now_us) * (HOST_CORE_HZ / 1000000UL);
+    now_us = us;
+}
+
+void host_advance_us(uint32_t us) {
+    uint64_t until = now_us + us;
+    while (alarm_isr && alarm_at <= until) {
+        void (*isr)(void) = alarm_isr;
+        alarm_isr         = NULL;
+        set_clock(MAX(alarm_at, now_us));
+        isr();
+    }
+    set_clock(until);
+}
+
+void host_alarm(uint64_t at_us, void (*isr)(void)) {
+    alarm_at  = at_us;
+    alarm_isr = isr;
+}
+
+uint64_t host_now_us(void) {
+    return now_us;
+}
+
+uint16_t timer_read(void) {
+    return (uint16_t)(now_us / 1000);
+}
+
+uint32_t timer_read32(void) {
+    return (uint32_t)(now_us / 1000);
+}
+
+uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16(timer_read(), last);
+}
+
+uint32_t timer_elapsed32(uint32_t last) {
+    return TIMER_DIFF_32(timer_read32(), last);
+}
+
+void wait_us(uint32_t us) {
+    host_advance_us(us);
+}
+
+// key_time.c reads SysTick; here the simulated clock is the time base.
+uint32_t key_time_now_us(void) {
+    return (uint32_t)now_us;
+}
+
+// Programming can only clear bits and erasing sets a whole sector, as on the
+// real part, so code that rewrites without erasing shows up in the result.
+static uint8_t  flash_ram[EXTERNAL_FLASH_SIZE];
+static uint8_t *flash = flash_ram;
+
+host_flash_stats_t  host_flash_stats;
+host_flash_timing_t host_flash_timing;
+
+void host_flash_reset(void) {
+    memset(flash, 0xFF, EXTERNAL_FLASH_SIZE);
+    memset(&host_flash_stats, 0, sizeof(host_flash_stats));
+}
+
+bool host_flash_map(const char *path) {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (st.st_size != 0 && st.st_size != EXTERNAL_FLASH_SIZE)) {
+        close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        static const uint8_t erased[EXTERNAL_FLASH_SECTOR_SIZE] = {[0 ... EXTERNAL_FLASH_SECTOR_SIZE - 1] = 0xFF};
+        for (uint32_t offset = 0; offset < EXTERNAL_FLASH_SIZE; offset += sizeof(erased)) {
+            if (write(fd, erased, sizeof(erased)) != sizeof(erased)) {
+                close(fd);
+                return false;
+            }
+        }
+    }
+    void *image = mmap(NULL, EXTERNAL_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        return false;
+    }
+    flash = image;
+    memset(&host_flash_stats, 0, sizeof(host_flash_stats));
+    return true;
+}
+
+void flash_init(void) {}
+
+static bool flash_range_ok(uint32_t addr, size_t len) {
+    return addr <= EXTERNAL_FLASH_SIZE && len <= EXTERNAL_FLASH_SIZE - addr;
+}
+
+flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
+    if (!flash_range_ok(addr, len)) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    memcpy(buf, &flash[addr], len);
+    host_flash_stats.reads++;
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_write_block(uint32_t addr, const void *buf, size_t len) {
+    if (!flash_range_ok(addr, len)) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    const uint8_t *bytes = buf;
+    for (size_t i = 0; i < len; i++) {
+        if (bytes[i] & ~flash[addr + i]) {
+            host_flash_stats.program_violations++;
+        }
+        flash[addr + i] &= bytes[i];
+    }
+    host_flash_stats.programs++;
+    host_advance_us(host_flash_timing.program_us * ((addr % EXTERNAL_FLASH_PAGE_SIZE + len + EXTERNAL_FLASH_PAGE_SIZE - 1) / EXTERNAL_FLASH_PAGE_SIZE));
+    return FLASH_STATUS_SUCCESS;
+}
+
+static flash_status_t flash_erase(uint32_t addr, uint32_t size, uint32_t us) {
+    addr &= ~(size - 1);
+    if (!flash_range_ok(addr, size)) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    memset(&flash[addr], 0xFF, size);
+    host_flash_stats.erases++;
+    host_advance_us(us);
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_erase_sector(uint32_t addr) {
+    return flash_erase(addr, EXTERNAL_FLASH_SECTOR_SIZE, host_flash_timing.erase_sector_us);
+}
+
+flash_status_t flash_erase_block(uint32_t addr) {
+    return flash_erase(addr, EXTERNAL_FLASH_BLOCK_SIZE, host_flash_timing.erase_block_us);
+}
+
+// 6KRO keyboard report: real and weak mods together, keys in press order.
+static uint8_t           real_mods;
+static uint8_t           weak_mods;
+static report_keyboard_t report;
+
+void (*host_keyboard_sink)(const report_keyboard_t *report);
+led_t host_led_state;
+
+void add_key(uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == key) {
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == KC_NO) {
+            report.keys[i] = key;
+            return;
+        }
+    }
+}
+
+void del_key(uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == key) {
+            report.keys[i] = KC_NO;
+        }
+    }
+}
+
+void clear_keys(void) {
+    memset(report.keys, 0, sizeof(report.keys));
+}
+
+uint8_t get_mods(void) {
+    return real_mods;
+}
+
+void add_weak_mods(uint8_t mods) {
+    weak_mods |= mods;
+}
+
+void del_weak_mods(uint8_t mods) {
+    weak_mods &= ~mods;
+}
+
+uint8_t get_weak_mods(void) {
+    return weak_mods;
+}
+
+void send_keyboard_report(void) {
+    report.mods = real_mods | weak_mods;
+    if (host_keyboard_sink) {
+        host_keyboard_sink(&report);
+    }
+}
+
+led_t host_keyboard_led_state(void) {
+    return host_led_state;
+}
+
+layer_state_t layer_state;
+layer_state_t default_layer_state = 1;
+
+uint8_t get_highest_layer(layer_state_t state) {
+    return state ? 31 - __builtin_clz(state) : 0;
+}
+
+void (*host_code_sink)(uint16_t code, bool pressed);
+
+void register_code16(uint16_t code) {
+    if (host_code_sink) {
+        host_code_sink(code, true);
+    }
+}
+
+void unregister_code16(uint16_t code) {
+    if (host_code_sink) {
+        host_code_sink(code, false);
+    }
+}
+
+// Lines idle high, as with the pull-ups every input here uses. Disabling a
+// line event also forgets its callback, as ChibiOS does.
+static struct {
+    bool          low;
+    uint8_t       mode;
+    palcallback_t callback;
+    void         *arg;
+} lines[HOST_GPIO_LINES];
+
+bool gpio_read_pin(pin_t pin) {
+    return pin < HOST_GPIO_LINES && !lines[pin].low;
+}
+
+void gpio_set_pin_input_high(pin_t pin) {}
+
+void palSetLineCallback(pin_t line, palcallback_t callback, void *arg) {
+    lines[line].callback = callback;
+    lines[line].arg      = arg;
+}
+
+void palEnableLineEvent(pin_t line, uint32_t mode) {
+    lines[line].mode = mode;
+}
+
+void palDisableLineEvent(pin_t line) {
+    lines[line].mode     = 0;
+    lines[line].callback = NULL;
+}
+
+void gpio_write_pin_high(pin_t pin) {
+    host_gpio_write(pin, true);
+}
+
+void gpio_write_pin_low(pin_t pin) {
+    host_gpio_write(pin, false);
+}
+
+void host_gpio_write(pin_t pin, bool level) {
+    if (lines[pin].low == !level) {
+        return;
+    }
+    lines[pin].low = !level;
+    uint8_t edge   = level ? PAL_EVENT_MODE_RISING_EDGE : PAL_EVENT_MODE_FALLING_EDGE;
+    if ((lines[pin].mode & edge) && lines[pin].callback) {
+        lines[pin].callback(lines[pin].arg);
+    }
+}
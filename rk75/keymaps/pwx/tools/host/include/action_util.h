@@ -0,0 +1,3 @@
+#pragma once
+
+#include "qmk_host.h"
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "qmk_host.h"
+
+// The part of the ChibiOS kernel the keymap's threads use, run cooperatively
+// on the simulated clock by host_chibios.c. There is the main thread and at
+// most one thread it creates, always of lower priority. That thread only
+// runs while the main thread lets it, exactly as on the board: when the main
+// thread drops below it, or sleeps, or blocks in one of the host_chibios_*
+// waits. It runs without the clock moving until it blocks again, on a
+// semaphore or on a driver.
+
+#define CH_CFG_ST_FREQUENCY 10000
+#define NORMALPRIO 128
+
+typedef uint8_t  tprio_t;
+typedef uint8_t  tstate_t;
+typedef int32_t  msg_t;
+typedef uint32_t sysinterval_t;
+
+#define MSG_OK 0
+
+#define CH_STATE_READY 0
+#define CH_STATE_SUSPENDED 2
+#define CH_STATE_WTSEM 5
+
+typedef struct {
+    tstate_t state;
+    tprio_t  prio;
+} thread_t;
+
+typedef struct {
+    bool taken;
+} binary_semaphore_t;
+
+typedef void (*tfunc_t)(void *arg);
+
+#define THD_WORKING_AREA(name, size) uint8_t name[size]
+#define THD_FUNCTION(name, arg) void name(void *arg)
+
+thread_t *chThdCreateStatic(void *wa, size_t size, tprio_t prio, tfunc_t func, void *arg);
+tprio_t   chThdSetPriority(tprio_t prio);
+void      chThdSleep(sysinterval_t ticks);
+void      chRegSetThreadName(const char *name);
+
+void  chBSemObjectInit(binary_semaphore_t *bsp, bool taken);
+msg_t chBSemWait(binary_semaphore_t *bsp);
+void  chBSemSignalI(binary_semaphore_t *bsp);
+
+static inline void chSysLock(void) {}
+static inline void chSysUnlock(void) {}
+
+// Host side.
+
+// The main thread waits until the clock reaches `at_us`, as it does when a
+// driver call sleeps on the USB endpoint; the other thread runs meanwhile.
+void host_chibios_sleep_until(uint64_t at_us);
+
+// Puts the calling thread to sleep in `state` until host_chibios_wake().
+// Only the created thread blocks; drivers call this.
+void host_chibios_block(tstate_t state);
+void host_chibios_wake(void);
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "qmk_host.h"
+
+// QMK's debounce interface, implemented by the keymap's custom debounce.
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_init(uint8_t num_rows);
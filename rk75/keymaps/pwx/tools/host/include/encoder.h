@@ -0,0 +1,7 @@
+#pragma once
+
+#include "qmk_host.h"
+
+// QMK's encoder.c queue; the test that links the driver provides it.
+bool encoder_queue_full(void);
+void encoder_queue_event(uint8_t index, bool clockwise);
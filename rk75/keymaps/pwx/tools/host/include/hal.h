@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ch.h"
+
+// The SPI driver as the WS2812 output uses it: spiSend() puts the calling
+// thread to sleep until the DMA transfer has ended, at host_spi_hz.
+typedef struct {
+    bool busy;
+} SPIDriver;
+
+extern SPIDriver SPIDM2;
+
+void spiSend(SPIDriver *spip, size_t n, const void *txbuf);
+
+// SPI clock of the transfers.
+extern uint32_t host_spi_hz;
+
+// CPU time charged to the sending thread before each transfer starts: the
+// encoding and DMA setup the host does not simulate on its own.
+extern uint32_t host_spi_setup_us;
+
+// Sees every transfer as it starts, with the time its DMA will end.
+extern void (*host_spi_sink)(const void *txbuf, size_t n, uint64_t end_us);
@@ -0,0 +1,274 @@
+#pragma once
+
+// Stands in for QMK_KEYBOARD_H when keymap modules are built on the host
+// (see ../Makefile). Only what the modules under test use is declared; the
+// keyboard's own config.h is force-included ahead of this, so flash layout
+// and tuning values are the ones the firmware is built with.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MATRIX_ROWS 6
+#define MATRIX_COLS 15
+
+typedef uint16_t matrix_row_t;
+#define MATRIX_ROW_SHIFTER ((matrix_row_t)1)
+
+#define PROGMEM
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
+
+#ifndef MIN
+#    define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+#    define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef enum {
+    TICK_EVENT        = 0,
+    KEY_EVENT         = 1,
+    ENCODER_CW_EVENT  = 2,
+    ENCODER_CCW_EVENT = 3,
+} keyevent_type_t;
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+    uint8_t  type;
+    bool     pressed;
+} keyevent_t;
+
+#define IS_KEYEVENT(event) ((event).type == KEY_EVENT)
+#define IS_ENCODEREVENT(event) ((event).type == ENCODER_CW_EVENT || (event).type == ENCODER_CCW_EVENT)
+
+typedef struct {
+    keyevent_t event;
+} keyrecord_t;
+
+typedef union {
+    uint8_t raw;
+    struct {
+        bool num_lock : 1;
+        bool caps_lock : 1;
+        bool scroll_lock : 1;
+        bool compose : 1;
+        bool kana : 1;
+        uint8_t reserved : 3;
+    };
+} led_t;
+
+// Basic keycodes, as in QMK's keycodes.h.
+enum {
+    KC_NO              = 0x00,
+    KC_A               = 0x04,
+    KC_Z               = 0x1D,
+    KC_1               = 0x1E,
+    KC_2               = 0x1F,
+    KC_3               = 0x20,
+    KC_4               = 0x21,
+    KC_5               = 0x22,
+    KC_6               = 0x23,
+    KC_7               = 0x24,
+    KC_8               = 0x25,
+    KC_9               = 0x26,
+    KC_0               = 0x27,
+    KC_ENTER           = 0x28,
+    KC_TAB             = 0x2B,
+    KC_SPACE           = 0x2C,
+    KC_MINUS           = 0x2D,
+    KC_EQUAL           = 0x2E,
+    KC_LEFT_BRACKET    = 0x2F,
+    KC_RIGHT_BRACKET   = 0x30,
+    KC_BACKSLASH       = 0x31,
+    KC_SEMICOLON       = 0x33,
+    KC_QUOTE           = 0x34,
+    KC_GRAVE           = 0x35,
+    KC_COMMA           = 0x36,
+    KC_DOT             = 0x37,
+    KC_SLASH           = 0x38,
+    KC_F19             = 0x6E,
+    KC_F20             = 0x6F,
+    KC_F21             = 0x70,
+    KC_F22             = 0x71,
+    KC_F23             = 0x72,
+    KC_F24             = 0x73,
+    KC_AUDIO_MUTE      = 0xA8,
+    KC_AUDIO_VOL_UP    = 0xA9,
+    KC_AUDIO_VOL_DOWN  = 0xAA,
+    KC_LEFT_CTRL       = 0xE0,
+    KC_LEFT_SHIFT      = 0xE1,
+};
+
+#define KC_VOLU KC_AUDIO_VOL_UP
+#define KC_VOLD KC_AUDIO_VOL_DOWN
+
+#define MOD_BIT(code) (1 << ((code) & 0x07))
+
+// action_layer.h
+typedef uint32_t layer_state_t;
+
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+
+uint8_t get_highest_layer(layer_state_t state);
+
+// GPIO lines as PAL encodes them: port * 16 + pad.
+typedef uint32_t pin_t;
+
+// clang-format off
+enum {
+    A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15,
+    B0, B1, B2, B3, B4, B5, B6, B7, B8, B9, B10, B11, B12, B13, B14, B15,
+    C0, C1, C2, C3, C4, C5, C6, C7, C8, C9, C10, C11, C12, C13, C14, C15,
+    HOST_GPIO_LINES,
+};
+// clang-format on
+
+#define PAL_EVENT_MODE_RISING_EDGE 1
+#define PAL_EVENT_MODE_FALLING_EDGE 2
+#define PAL_EVENT_MODE_BOTH_EDGES 3
+
+typedef void (*palcallback_t)(void *arg);
+
+bool gpio_read_pin(pin_t pin);
+void gpio_set_pin_input_high(pin_t pin);
+void palSetLineCallback(pin_t line, palcallback_t callback, void *arg);
+void palEnableLineEvent(pin_t line, uint32_t mode);
+void palDisableLineEvent(pin_t line);
+void gpio_write_pin_high(pin_t pin);
+void gpio_write_pin_low(pin_t pin);
+
+// Busy-waits on the simulated clock.
+void wait_us(uint32_t us);
+
+// timer.h; driven by the simulated clock in host_qmk.c.
+#define TIMER_DIFF_16(a, b) ((uint16_t)((a) - (b)))
+#define TIMER_DIFF_32(a, b) ((uint32_t)((a) - (b)))
+
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+
+// quantum.h; supplied by the test.
+uint32_t last_input_activity_elapsed(void);
+
+// flash_spi.h; a NOR flash emulated in host_qmk.c.
+#define EXTERNAL_FLASH_PAGE_SIZE 256
+#define EXTERNAL_FLASH_SECTOR_SIZE (4 * 1024)
+#define EXTERNAL_FLASH_BLOCK_SIZE (64 * 1024)
+#define EXTERNAL_FLASH_SIZE (512 * 1024)
+
+typedef enum {
+    FLASH_STATUS_SUCCESS     = 0,
+    FLASH_STATUS_ERROR       = -1,
+    FLASH_STATUS_TIMEOUT     = -2,
+    FLASH_STATUS_BAD_ADDRESS = -3,
+    FLASH_STATUS_BUSY        = -4,
+} flash_status_t;
+
+void           flash_init(void);
+flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len);
+flash_status_t flash_write_block(uint32_t addr, const void *buf, size_t len);
+flash_status_t flash_erase_sector(uint32_t addr);
+flash_status_t flash_erase_block(uint32_t addr);
+
+// Cortex-M3 DWT cycle counter; runs at HOST_CORE_HZ off the simulated clock.
+#define HOST_CORE_HZ 96000000UL
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+extern CoreDebug_Type host_core_debug;
+extern DWT_Type       host_dwt;
+
+#define CoreDebug (&host_core_debug)
+#define DWT (&host_dwt)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+
+// action_util.h and host.h; the report goes to host_keyboard_sink.
+#define KEYBOARD_REPORT_KEYS 6
+
+typedef struct {
+    uint8_t mods;
+    uint8_t reserved;
+    uint8_t keys[KEYBOARD_REPORT_KEYS];
+} report_keyboard_t;
+
+void    add_key(uint8_t key);
+void    del_key(uint8_t key);
+void    clear_keys(void);
+uint8_t get_mods(void);
+void    add_weak_mods(uint8_t mods);
+void    del_weak_mods(uint8_t mods);
+uint8_t get_weak_mods(void);
+void    send_keyboard_report(void);
+led_t   host_keyboard_led_state(void);
+
+// rgb_matrix_drivers.h
+typedef struct {
+    void (*init)(void);
+    void (*flush)(void);
+    void (*set_color)(int index, uint8_t r, uint8_t g, uint8_t b);
+    void (*set_color_all)(uint8_t r, uint8_t g, uint8_t b);
+} rgb_matrix_driver_t;
+
+// quantum.h; the codes go to host_code_sink.
+void register_code16(uint16_t code);
+void unregister_code16(uint16_t code);
+
+// Host side of the simulation.
+
+// Moves the simulated clock on; every timer reads it.
+void     host_advance_us(uint32_t us);
+uint64_t host_now_us(void);
+
+// The one interrupt source: `isr` runs once when the clock reaches `at_us`,
+// inside whatever call advances it there, as a real interrupt would.
+void host_alarm(uint64_t at_us, void (*isr)(void));
+
+extern void (*host_keyboard_sink)(const report_keyboard_t *report);
+extern void (*host_code_sink)(uint16_t code, bool pressed);
+extern led_t host_led_state;
+
+// Drives an input line from outside; an enabled line event fires its
+// callback on the edge, as the EXTI interrupt would.
+void host_gpio_write(pin_t pin, bool level);
+
+typedef struct {
+    uint32_t reads;
+    uint32_t programs;
+    uint32_t erases;
+    uint32_t program_violations; // 0 -> 1 bit changes a real part would not make
+} host_flash_stats_t;
+
+// Time each operation takes on the simulated clock; all 0 unless a test
+// sets them.
+typedef struct {
+    uint32_t program_us; // per page programmed
+    uint32_t erase_sector_us;
+    uint32_t erase_block_us;
+} host_flash_timing_t;
+
+extern host_flash_stats_t  host_flash_stats;
+extern host_flash_timing_t host_flash_timing;
+
+// Erased flash; clears the statistics too.
+void host_flash_reset(void);
+
+// Backs the flash with an image file, created erased if it does not exist,
+// so what one run leaves behind is there for the next. False on any error.
+bool host_flash_map(const char *path);
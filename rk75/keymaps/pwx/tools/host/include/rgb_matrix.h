@@ -0,0 +1,8 @@
+#pragma once
+
+#include "qmk_host.h"
+
+// QMK's RGB matrix; the test that links the driver provides the task.
+extern const rgb_matrix_driver_t rgb_matrix_driver;
+
+void rgb_matrix_task(void);
@@ -0,0 +1,126 @@
+// The scan thread's key event ring (utils/key_event_queue.h) between two
+// real threads.
+//
+// First the single-threaded edges: empty, full at KEY_EVENT_QUEUE_SIZE and
+// indices wrapping at 256. Then a producer pushes a numbered stream while a
+// consumer drains it, and every event must arrive once, in order and whole.
+// The Makefile builds this with ThreadSanitizer when the compiler has it,
+// which also reports a slot read that the index stores do not order after
+// its write, on any host memory model.
+//
+// Usage: key_event_queue_test [events]
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "key_event_queue.h"
+
+static bool check(const char *name, bool ok) {
+    printf("%-44s %s\n", name, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+// Every field follows from the sequence number, so a torn slot shows.
+static key_event_t numbered(uint32_t seq) {
+    return (key_event_t){.time = seq, .row = seq % 6, .col = (seq / 6) % 15, .pressed = (seq >> 3) & 1};
+}
+
+static bool is_numbered(const key_event_t *event, uint32_t seq) {
+    key_event_t expected = numbered(seq);
+    return event->time == expected.time && event->row == expected.row && event->col == expected.col && event->pressed == expected.pressed;
+}
+
+// Fills and drains across several laps of the 8-bit indices.
+static bool test_single_thread(void) {
+    static key_event_queue_t queue;
+    key_event_t              event;
+    bool                     ok = true, full_ok = true, order_ok = true;
+
+    ok &= check("empty queue has nothing to peek", key_event_queue_peek(&queue) == NULL && key_event_queue_count(&queue) == 0);
+
+    uint32_t pushed = 0, popped = 0;
+    for (int lap = 0; lap < 40; lap++) {
+        while (event = numbered(pushed), key_event_queue_push(&queue, &event)) {
+            pushed++;
+        }
+        full_ok &= key_event_queue_count(&queue) == KEY_EVENT_QUEUE_SIZE;
+        // Taking some but not all leaves room for exactly that many.
+        uint32_t take = 1 + lap % KEY_EVENT_QUEUE_SIZE;
+        for (uint32_t i = 0; i < take; i++) {
+            const key_event_t *head = key_event_queue_peek(&queue);
+            order_ok &= head && is_numbered(head, popped);
+            key_event_queue_pop(&queue);
+            popped++;
+        }
+        full_ok &= key_event_queue_count(&queue) == KEY_EVENT_QUEUE_SIZE - take;
+    }
+    while (key_event_queue_peek(&queue)) {
+        order_ok &= is_numbered(key_event_queue_peek(&queue), popped);
+        key_event_queue_pop(&queue);
+        popped++;
+    }
+    ok &= check("full at KEY_EVENT_QUEUE_SIZE on every lap", full_ok);
+    ok &= check("FIFO order across index wrap-around", order_ok && popped == pushed && pushed > 2 * 256);
+    ok &= check("empty again after draining", key_event_queue_count(&queue) == 0);
+    return ok;
+}
+
+static key_event_queue_t shared;
+static uint32_t          total;
+static uint32_t          full_seen;
+
+static void *producer(void *arg) {
+    (void)arg;
+    for (uint32_t seq = 0; seq < total;) {
+        key_event_t event = numbered(seq);
+        if (key_event_queue_push(&shared, &event)) {
+            seq++;
+        } else {
+            full_seen++;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg) {
+    uint32_t *bad = arg;
+    for (uint32_t seq = 0; seq < total;) {
+        const key_event_t *event = key_event_queue_peek(&shared);
+        if (!event) {
+            sched_yield();
+            continue;
+        }
+        if (!is_numbered(event, seq)) {
+            if (!*bad) {
+                fprintf(stderr, "event %u arrived as time %u, row %u, col %u, %s\n", seq, event->time, event->row, event->col, event->pressed ? "down" : "up");
+            }
+            (*bad)++;
+        }
+        key_event_queue_pop(&shared);
+        seq++;
+    }
+    return NULL;
+}
+
+static bool test_two_threads(void) {
+    pthread_t produce, consume;
+    uint32_t  bad = 0;
+    pthread_create(&consume, NULL, consumer, &bad);
+    pthread_create(&produce, NULL, producer, NULL);
+    pthread_join(produce, NULL);
+    pthread_join(consume, NULL);
+    printf("%u events through a %d-slot queue, producer found it full %u times\n", total, KEY_EVENT_QUEUE_SIZE, full_seen);
+    return check("two threads: every event once, in order, whole", bad == 0 && key_event_queue_peek(&shared) == NULL);
+}
+
+int main(int argc, char **argv) {
+    bool ok = true;
+
+    total = argc > 1 ? strtoul(argv[1], NULL, 0) : 100000;
+    ok &= test_single_thread();
+    ok &= test_two_threads();
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,627 @@
+// Keystroke latency through the firmware main loop, on the simulated clock.
+//
+// Replays a keystroke script through the keymap's own adaptive debounce,
+// render scheduler and LED driver, with its output thread, and prints the
+// latency from the physical switch edge to the report leaving the keyboard
+// and to the pressed key's LED:
+//
+//   matrix scan   fixed cost per pass; the rows are sampled at its start
+//   debounce      utils/adaptive_debounce.c
+//   processing    fixed cost per key event
+//   USB           a report leaves on the first host poll after it is queued;
+//                 a second one in the same interval sleeps the main thread
+//                 until the endpoint is free, and the LED thread runs then
+//   RGB matrix    QMK's rgb_matrix_task() state machine, one chunk of
+//                 RGB_MATRIX_LED_PROCESS_LIMIT LEDs per call, flushing once
+//                 RGB_MATRIX_LED_FLUSH_LIMIT has passed since the frame
+//                 started; utils/rgb_scheduler.c adds chunks in housekeeping
+//   LED output    utils/rgb_driver.c and its thread, on the cooperative
+//                 kernel of host_chibios.c; a transfer takes the frame's SPI
+//                 time, and the thread only learns it has ended when the
+//                 main loop next lets it run
+//   flash         an optional periodic stall in housekeeping
+//   game mode     --game-mode: no RGB rendering, and --game-process-us per
+//                 key event
+//   key LED       a press lights its LED in white, from housekeeping in its
+//                 own flush (utils/reactive_keys.c) or, with --led-path
+//                 frame, only in the frames rendered after it; the LED
+//                 counts as lit when the first transfer carrying it ends
+//
+// Costs come from the options, best taken from the on-target cycle benchmark
+// (CYCLE_BENCH_ENABLE) and the UART event trace (EVENT_TRACE_ENABLE). Debounce
+// windows, render budgets and frame limits are the firmware's own, from
+// config.h and the module headers. The same script and options always give
+// the same result.
+//
+// A script has one physical edge per line, '#' starts a comment:
+//
+//   <time ms> <row> <col> down|up
+//
+// Without a script, --wpm generates seeded typing on the letter keys;
+// --bounce-ms adds contact bounce after every edge. The run fails when a
+// change reaches QMK that no edge explains, when an edge is never reported
+// or when a pressed key's LED never lights.
+//
+// Usage: latency_sim [options] [script]
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "adaptive_debounce.h"
+#include "ch.h"
+#include "debounce.h"
+#include "hal.h"
+#include "hid_commands.h"
+#include "key_time.h"
+#include "matrix_scan.h"
+#include "rgb_driver.h"
+#include "rgb_matrix.h"
+#include "rgb_scheduler.h"
+#include "ws2812_encode.h"
+
+#ifndef RGB_MATRIX_LED_FLUSH_LIMIT
+#    define RGB_MATRIX_LED_FLUSH_LIMIT 16 // QMK's default
+#endif
+
+#define KEY_COLOR RGB_PIXEL(255, 255, 255)
+
+static struct {
+    uint32_t seed;
+    double   wpm;
+    uint32_t keystrokes;
+    double   bounce_ms;
+    double   scan_us;
+    double   process_us;
+    double   housekeeping_us;
+    double   poll_ms;
+    double   poll_phase_us;
+    bool     no_rgb;
+    bool     no_rgb_scheduler;
+    double   render_us_per_led;
+    double   indicators_us;
+    double   handoff_us;
+    bool     led_path_frame;
+    double   flash_every_ms;
+    double   flash_stall_us;
+    bool     game_mode;
+    double   game_process_us;
+} opt = {
+    .seed              = 1,
+    .wpm               = 90,
+    .keystrokes        = 1000,
+    .bounce_ms         = 2,
+    .scan_us           = 25,
+    .process_us        = 40,
+    .housekeeping_us   = 10,
+    .poll_ms           = 1,
+    .poll_phase_us     = 370,
+    .render_us_per_led = 1.5,
+    .indicators_us     = 20,
+    .handoff_us        = 5,
+    .flash_stall_us    = 700,
+    .game_process_us   = 25,
+};
+
+static uint64_t rng_state;
+
+// splitmix64, so a seed gives the same script everywhere.
+static double rng_uniform(double lo, double hi) {
+    uint64_t z = (rng_state += 0x9E3779B97F4A7C15ULL);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return lo + (hi - lo) * (double)(z >> 11) / (double)(1ULL << 53);
+}
+
+typedef struct {
+    uint64_t t;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+    uint32_t order;
+} edge_t;
+
+typedef struct {
+    edge_t  *v;
+    uint32_t n;
+    uint32_t cap;
+} edges_t;
+
+static void push_edge(edges_t *edges, double t, uint8_t row, uint8_t col, bool pressed) {
+    if (edges->n == edges->cap) {
+        edges->cap = edges->cap ? edges->cap * 2 : 256;
+        edges->v   = realloc(edges->v, edges->cap * sizeof(edge_t));
+    }
+    edges->v[edges->n] = (edge_t){.t = (uint64_t)llround(t), .row = row, .col = col, .pressed = pressed, .order = edges->n};
+    edges->n++;
+}
+
+static int edge_cmp(const void *a, const void *b) {
+    const edge_t *x = a, *y = b;
+    if (x->t != y->t) {
+        return x->t < y->t ? -1 : 1;
+    }
+    return x->order < y->order ? -1 : x->order > y->order;
+}
+
+static void sort_edges(edges_t *edges) {
+    qsort(edges->v, edges->n, sizeof(edge_t), edge_cmp);
+}
+
+static void load_script(const char *path, edges_t *edges) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    char line[256];
+    for (int number = 1; fgets(line, sizeof(line), f); number++) {
+        char *hash = strchr(line, '#');
+        if (hash) {
+            *hash = '\0';
+        }
+        double   ms;
+        unsigned row, col;
+        char     state[8], rest;
+        int      fields = sscanf(line, "%lf %u %u %7s %c", &ms, &row, &col, state, &rest);
+        if (fields <= 0) {
+            continue;
+        }
+        if (fields != 4 || row >= MATRIX_ROWS || col >= MATRIX_COLS || (strcmp(state, "down") && strcmp(state, "up"))) {
+            fprintf(stderr, "%s:%d: expected \"<ms> <row> <col> down|up\"\n", path, number);
+            exit(2);
+        }
+        push_edge(edges, ms * 1000, row, col, !strcmp(state, "down"));
+    }
+    fclose(f);
+    sort_edges(edges);
+}
+
+static void typing_script(edges_t *edges) {
+    double interval_us = 60e6 / (opt.wpm * 5);
+    double released_at[3][10];
+    for (uint8_t k = 0; k < 30; k++) {
+        released_at[k / 10][k % 10] = -INFINITY;
+    }
+    double t = 1000;
+    for (uint32_t i = 0; i < opt.keystrokes; i++) {
+        // A finger needs some time between releasing a key and pressing it again.
+        uint8_t free_keys[30], count = 0;
+        for (uint8_t k = 0; k < 30; k++) {
+            if (released_at[k / 10][k % 10] < t - 30e3) {
+                free_keys[count++] = k;
+            }
+        }
+        uint8_t key  = free_keys[(uint8_t)rng_uniform(0, count)];
+        double  hold = rng_uniform(60e3, 110e3);
+        push_edge(edges, t, 2 + key / 10, 1 + key % 10, true);
+        push_edge(edges, t + hold, 2 + key / 10, 1 + key % 10, false);
+        released_at[key / 10][key % 10] = t + hold;
+        t += interval_us * rng_uniform(0.6, 1.4);
+    }
+    sort_edges(edges);
+}
+
+// Raw contact transitions: every edge, then bounce until it has settled.
+static void raw_transitions(const edges_t *edges, edges_t *transitions) {
+    for (uint32_t i = 0; i < edges->n; i++) {
+        const edge_t *e = &edges->v[i];
+        push_edge(transitions, e->t, e->row, e->col, e->pressed);
+        if (opt.bounce_ms > 0) {
+            double t     = e->t;
+            bool   state = e->pressed;
+            while ((t += rng_uniform(100, 600)) < e->t + opt.bounce_ms * 1000) {
+                state = !state;
+                push_edge(transitions, t, e->row, e->col, state);
+            }
+            if (state != e->pressed) {
+                push_edge(transitions, e->t + opt.bounce_ms * 1000, e->row, e->col, e->pressed);
+            }
+        }
+    }
+    sort_edges(transitions);
+}
+
+typedef struct {
+    double  *v;
+    uint32_t n;
+    uint32_t cap;
+} samples_t;
+
+static void push_sample(samples_t *s, double us) {
+    if (s->n == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 256;
+        s->v   = realloc(s->v, s->cap * sizeof(double));
+    }
+    s->v[s->n++] = us;
+}
+
+// Simulated clock in microseconds, with fractional costs carried over.
+static double carry_us;
+
+static void spend_us(double us) {
+    carry_us += us;
+    uint32_t whole = (uint32_t)carry_us;
+    carry_us -= whole;
+    host_advance_us(whole);
+}
+
+// QMK's rgb_matrix_task(): start a frame once RGB_MATRIX_LED_FLUSH_LIMIT has
+// passed since the last one started, render one chunk per call and flush on
+// the call after the last. The effect is an animated gradient, with the LEDs
+// of held keys in KEY_COLOR, as a reactive effect draws them.
+static enum { SYNCING, RENDERING, FLUSHING } rgb_state = SYNCING;
+static uint8_t  rgb_iter;
+static uint32_t rgb_frame_start;
+static uint32_t rgb_frames;
+static bool     key_lit[RGB_MATRIX_LED_COUNT];
+
+void rgb_matrix_task(void) {
+    switch (rgb_state) {
+        case SYNCING:
+            if (timer_elapsed32(rgb_frame_start) >= RGB_MATRIX_LED_FLUSH_LIMIT) {
+                rgb_frame_start = timer_read32();
+                rgb_iter        = 0;
+                rgb_state       = RENDERING;
+            }
+            break;
+        case RENDERING: {
+            uint8_t led_min = rgb_iter * RGB_MATRIX_LED_PROCESS_LIMIT;
+            uint8_t led_max = MIN(led_min + RGB_MATRIX_LED_PROCESS_LIMIT, RGB_MATRIX_LED_COUNT);
+            for (uint8_t i = led_min; i < led_max; i++) {
+                uint8_t level = (rgb_frames * 3 + i) & 0x7F;
+                if (key_lit[i]) {
+                    rgb_matrix_driver.set_color(i, 255, 255, 255);
+                } else {
+                    rgb_matrix_driver.set_color(i, level, 0x40, 0x7F - level);
+                }
+            }
+            spend_us((led_max - led_min) * opt.render_us_per_led + opt.indicators_us);
+            rgb_scheduler_chunk(led_min, led_max);
+            rgb_iter++;
+            if (led_max == RGB_MATRIX_LED_COUNT) {
+                rgb_state = FLUSHING;
+            }
+            break;
+        }
+        case FLUSHING:
+            spend_us(opt.handoff_us);
+            rgb_matrix_driver.flush();
+            rgb_frames++;
+            rgb_state = SYNCING;
+            break;
+    }
+}
+
+static uint32_t last_input_ms;
+
+uint32_t last_input_activity_elapsed(void) {
+    return timer_elapsed32(last_input_ms);
+}
+
+static uint32_t sample_us;
+
+uint32_t matrix_sample_time_us(void) {
+    return sample_us;
+}
+
+void key_time_stamp(uint8_t row, uint8_t col, uint32_t sampled_us) {}
+
+static uint8_t key_led(uint8_t row, uint8_t col) {
+    return (row * MATRIX_COLS + col) % RGB_MATRIX_LED_COUNT;
+}
+
+// Presses waiting for their LED: physical edge and when the event was
+// processed, per LED.
+typedef struct {
+    bool     waiting;
+    uint64_t edge_us;
+    uint64_t event_us;
+} led_wait_t;
+
+static led_wait_t led_wait[RGB_MATRIX_LED_COUNT];
+static samples_t  to_led;
+static uint32_t   transfers;
+static uint64_t   transfer_us;
+
+static void spi_sink(const void *txbuf, size_t n, uint64_t end_us) {
+    static uint32_t lit[WS2812_SPI_FRAME_WORDS(1)];
+    const uint32_t *words = txbuf;
+    ws2812_encode_pixel(lit, 0, KEY_COLOR);
+    transfers++;
+    transfer_us = end_us - host_now_us();
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        const uint32_t *px = &words[WS2812_SPI_PREAMBLE_WORDS + 3 * i];
+        if (led_wait[i].waiting && led_wait[i].event_us <= host_now_us() && !memcmp(px, &lit[WS2812_SPI_PREAMBLE_WORDS], 3 * sizeof(uint32_t))) {
+            led_wait[i].waiting = false;
+            push_sample(&to_led, end_us - led_wait[i].edge_us);
+        }
+    }
+}
+
+typedef struct {
+    samples_t to_report;
+    samples_t to_host;
+    uint32_t  spurious;
+    uint32_t  missed;
+    uint32_t  unlit;
+    uint32_t  overruns;
+    double    seconds;
+} result_t;
+
+// Next unreported edge of every key, as an index into the edge list.
+static uint32_t next_edge[MATRIX_ROWS][MATRIX_COLS];
+
+static void seek_edge(const edges_t *edges, uint8_t row, uint8_t col) {
+    uint32_t i = next_edge[row][col];
+    while (i < edges->n && (edges->v[i].row != row || edges->v[i].col != col)) {
+        i++;
+    }
+    next_edge[row][col] = i;
+}
+
+static void simulate(const edges_t *edges, const edges_t *transitions, result_t *result) {
+    uint64_t poll_us   = (uint64_t)llround(opt.poll_ms * 1000);
+    uint64_t phase_us  = (uint64_t)llround(opt.poll_phase_us) % poll_us;
+    uint64_t end       = (edges->n ? edges->v[edges->n - 1].t : 0) + 100000;
+    uint64_t usb_free  = 0;
+    uint64_t flash_at  = opt.flash_every_ms > 0 ? (uint64_t)llround(opt.flash_every_ms * 1000) : UINT64_MAX;
+    uint32_t next_raw  = 0;
+    bool     rgb       = !opt.no_rgb && !opt.game_mode;
+    double   event_us  = opt.game_mode ? opt.game_process_us : opt.process_us;
+    int16_t  show_led  = -1;
+
+    matrix_row_t raw[MATRIX_ROWS]    = {0};
+    matrix_row_t cooked[MATRIX_ROWS] = {0};
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            seek_edge(edges, row, col);
+        }
+    }
+    host_spi_sink = spi_sink;
+    rgb_matrix_driver.init();
+    debounce_init(MATRIX_ROWS);
+
+    while (host_now_us() < end) {
+        // Matrix scan.
+        sample_us    = key_time_now_us();
+        bool changed = false;
+        for (; next_raw < transitions->n && transitions->v[next_raw].t <= host_now_us(); next_raw++) {
+            const edge_t *e    = &transitions->v[next_raw];
+            matrix_row_t  mask = MATRIX_ROW_SHIFTER << e->col;
+            matrix_row_t  row  = e->pressed ? raw[e->row] | mask : raw[e->row] & ~mask;
+            changed |= row != raw[e->row];
+            raw[e->row] = row;
+        }
+        spend_us(opt.scan_us);
+
+        matrix_row_t before[MATRIX_ROWS];
+        memcpy(before, cooked, sizeof(before));
+        if (debounce(raw, cooked, MATRIX_ROWS, changed)) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    matrix_row_t mask = MATRIX_ROW_SHIFTER << col;
+                    if (!((before[row] ^ cooked[row]) & mask)) {
+                        continue;
+                    }
+                    bool pressed = cooked[row] & mask;
+                    spend_us(event_us);
+                    const edge_t *e = next_edge[row][col] < edges->n ? &edges->v[next_edge[row][col]] : NULL;
+                    if (!e || e->t > host_now_us() || e->pressed != pressed) {
+                        result->spurious++;
+                        continue;
+                    }
+                    next_edge[row][col]++;
+                    seek_edge(edges, row, col);
+                    last_input_ms = timer_read32();
+
+                    // The endpoint takes one report per poll.
+                    if (host_now_us() < usb_free) {
+                        host_chibios_sleep_until(usb_free);
+                    }
+                    uint64_t now       = host_now_us();
+                    uint64_t delivered = now < phase_us ? phase_us : phase_us + ((now - phase_us) / poll_us + 1) * poll_us;
+                    usb_free           = delivered;
+                    push_sample(&result->to_report, now - e->t);
+                    push_sample(&result->to_host, delivered - e->t);
+
+                    uint8_t led  = key_led(row, col);
+                    key_lit[led] = pressed;
+                    if (pressed && rgb) {
+                        led_wait[led] = (led_wait_t){.waiting = true, .edge_us = e->t, .event_us = now};
+                        if (!opt.led_path_frame) {
+                            show_led = led;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (rgb) {
+            rgb_matrix_task();
+        }
+
+        // Housekeeping.
+        if (host_now_us() >= flash_at) {
+            spend_us(opt.flash_stall_us);
+            flash_at += (uint64_t)llround(opt.flash_every_ms * 1000);
+        }
+        spend_us(opt.housekeeping_us);
+        if (show_led >= 0) {
+            spend_us(opt.handoff_us);
+            rgb_driver_show_pixel(show_led, KEY_COLOR);
+            rgb_driver_write_shown();
+            show_led = -1;
+        }
+        if (rgb && !opt.no_rgb_scheduler) {
+            rgb_scheduler_task();
+        }
+        rgb_driver_task();
+        rgb_driver_yield();
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            for (uint32_t i = next_edge[row][col]; i < edges->n; i++) {
+                result->missed += edges->v[i].row == row && edges->v[i].col == col;
+            }
+        }
+    }
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        result->unlit += led_wait[i].waiting;
+    }
+    uint8_t reply[32] = {PWX_HID_COMMAND_ID, PWX_HID_RGB_SCHEDULER, RGB_SCHEDULER_OP_READ};
+    rgb_scheduler_hid_command(reply, sizeof(reply));
+    result->overruns = reply[18] | reply[19] << 8 | reply[20] << 16 | (uint32_t)reply[21] << 24;
+    result->seconds  = host_now_us() / 1e6;
+}
+
+static int sample_cmp(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void summarise(const char *name, samples_t *s) {
+    if (!s->n) {
+        printf("%-24s no samples\n", name);
+        return;
+    }
+    qsort(s->v, s->n, sizeof(double), sample_cmp);
+#define PCT(p) (s->v[MIN(s->n - 1, (uint32_t)(s->n * (p)))] / 1000)
+    printf("%-24s n=%-6u min=%6.2f  p50=%6.2f  p90=%6.2f  p99=%6.2f  max=%6.2f ms\n", name, s->n, s->v[0] / 1000, PCT(0.5), PCT(0.9), PCT(0.99), s->v[s->n - 1] / 1000);
+#undef PCT
+}
+
+static void histogram(const samples_t *s) {
+    const double bucket_us = 250;
+    const int    width     = 50;
+    if (!s->n) {
+        return;
+    }
+    int first = s->v[0] / bucket_us, last = s->v[s->n - 1] / bucket_us;
+    int counts[last - first + 1];
+    memset(counts, 0, sizeof(counts));
+    int peak = 0;
+    for (uint32_t i = 0; i < s->n; i++) {
+        int c = ++counts[(int)(s->v[i] / bucket_us) - first];
+        peak  = MAX(peak, c);
+    }
+    for (int b = first; b <= last; b++) {
+        int bar = (counts[b - first] * width + peak - 1) / peak;
+        printf("  %6.2f ms %6d %.*s\n", b * bucket_us / 1000, counts[b - first], bar, "##################################################");
+    }
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [options] [script]\n"
+            "  --seed N  --wpm N  --keystrokes N  --bounce-ms MS\n"
+            "  --scan-us US  --process-us US  --housekeeping-us US\n"
+            "  --poll-ms MS  --poll-phase-us US\n"
+            "  --no-rgb  --no-rgb-scheduler  --render-us-per-led US  --indicators-us US\n"
+            "  --spi-hz HZ  --handoff-us US  --encode-us US  --led-path fast|frame\n"
+            "  --flash-every-ms MS  --flash-stall-us US\n"
+            "  --game-mode  --game-process-us US\n",
+            name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    enum { SEED = 256, WPM, KEYSTROKES, BOUNCE, SCAN, PROCESS, HOUSEKEEPING, POLL, PHASE, NO_RGB, NO_SCHEDULER, RENDER, INDICATORS, SPI_HZ, HANDOFF, ENCODE, LED_PATH, FLASH_EVERY, FLASH_STALL, GAME, GAME_PROCESS };
+    static const struct option options[] = {
+        {"seed", required_argument, NULL, SEED},
+        {"wpm", required_argument, NULL, WPM},
+        {"keystrokes", required_argument, NULL, KEYSTROKES},
+        {"bounce-ms", required_argument, NULL, BOUNCE},
+        {"scan-us", required_argument, NULL, SCAN},
+        {"process-us", required_argument, NULL, PROCESS},
+        {"housekeeping-us", required_argument, NULL, HOUSEKEEPING},
+        {"poll-ms", required_argument, NULL, POLL},
+        {"poll-phase-us", required_argument, NULL, PHASE},
+        {"no-rgb", no_argument, NULL, NO_RGB},
+        {"no-rgb-scheduler", no_argument, NULL, NO_SCHEDULER},
+        {"render-us-per-led", required_argument, NULL, RENDER},
+        {"indicators-us", required_argument, NULL, INDICATORS},
+        {"spi-hz", required_argument, NULL, SPI_HZ},
+        {"handoff-us", required_argument, NULL, HANDOFF},
+        {"encode-us", required_argument, NULL, ENCODE},
+        {"led-path", required_argument, NULL, LED_PATH},
+        {"flash-every-ms", required_argument, NULL, FLASH_EVERY},
+        {"flash-stall-us", required_argument, NULL, FLASH_STALL},
+        {"game-mode", no_argument, NULL, GAME},
+        {"game-process-us", required_argument, NULL, GAME_PROCESS},
+        {0},
+    };
+    host_spi_setup_us = 60;
+    for (int c; (c = getopt_long(argc, argv, "", options, NULL)) != -1;) {
+        switch (c) {
+            case SEED: opt.seed = strtoul(optarg, NULL, 0); break;
+            case WPM: opt.wpm = atof(optarg); break;
+            case KEYSTROKES: opt.keystrokes = strtoul(optarg, NULL, 0); break;
+            case BOUNCE: opt.bounce_ms = atof(optarg); break;
+            case SCAN: opt.scan_us = atof(optarg); break;
+            case PROCESS: opt.process_us = atof(optarg); break;
+            case HOUSEKEEPING: opt.housekeeping_us = atof(optarg); break;
+            case POLL: opt.poll_ms = atof(optarg); break;
+            case PHASE: opt.poll_phase_us = atof(optarg); break;
+            case NO_RGB: opt.no_rgb = true; break;
+            case NO_SCHEDULER: opt.no_rgb_scheduler = true; break;
+            case RENDER: opt.render_us_per_led = atof(optarg); break;
+            case INDICATORS: opt.indicators_us = atof(optarg); break;
+            case SPI_HZ: host_spi_hz = strtoul(optarg, NULL, 0); break;
+            case HANDOFF: opt.handoff_us = atof(optarg); break;
+            case ENCODE: host_spi_setup_us = strtoul(optarg, NULL, 0); break;
+            case LED_PATH:
+                if (strcmp(optarg, "fast") && strcmp(optarg, "frame")) {
+                    usage(argv[0]);
+                }
+                opt.led_path_frame = !strcmp(optarg, "frame");
+                break;
+            case FLASH_EVERY: opt.flash_every_ms = atof(optarg); break;
+            case FLASH_STALL: opt.flash_stall_us = atof(optarg); break;
+            case GAME: opt.game_mode = true; break;
+            case GAME_PROCESS: opt.game_process_us = atof(optarg); break;
+            default: usage(argv[0]);
+        }
+    }
+    if (optind < argc - 1 || opt.poll_ms <= 0 || opt.wpm <= 0 || !host_spi_hz) {
+        usage(argv[0]);
+    }
+
+    rng_state = opt.seed;
+    edges_t edges = {0}, transitions = {0};
+    if (optind < argc) {
+        load_script(argv[optind], &edges);
+    } else {
+        typing_script(&edges);
+    }
+    raw_transitions(&edges, &transitions);
+
+    result_t result = {0};
+    simulate(&edges, &transitions, &result);
+    bool rgb = !opt.no_rgb && !opt.game_mode;
+
+    printf("# %u edges, debounce adaptive %d ms, WS2812 transfer ", edges.n, ADAPTIVE_DEBOUNCE_BASE_MS);
+    if (rgb) {
+        printf("%.2f ms\n", transfer_us / 1000.0);
+    } else {
+        printf("off\n");
+    }
+    summarise("edge -> report queued", &result.to_report);
+    summarise("edge -> host", &result.to_host);
+    if (rgb) {
+        summarise(opt.led_path_frame ? "edge -> key LED (frame)" : "edge -> key LED (fast)", &to_led);
+        printf("RGB frames %u (%.1f fps), %u transfers, render budget overruns ", rgb_frames, rgb_frames / result.seconds, transfers);
+        if (opt.no_rgb_scheduler) {
+            printf("n/a\n");
+        } else {
+            printf("%u\n", result.overruns);
+        }
+    }
+    printf("spurious events %u, edges never reported %u, key LEDs never lit %u\n", result.spurious, result.missed, result.unlit);
+    histogram(&result.to_host);
+    return result.spurious || result.missed || result.unlit ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+#include "macro_store.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Types a snippet through macro_store.c the way the keyboard does, one
+// macro_store_task() per main loop pass, against a USB host that polls the
+// keyboard endpoint every millisecond. The endpoint holds one report: one
+// sent before the host polled the previous is lost. The host turns the key
+// presses it sees back into text on a US layout, which has to match the
+// snippet exactly.
+//
+// Prints the typing speed and the reports sent and lost for a range of
+// main loop pass times; exits non-zero on any loss or mismatch.
+
+#define POLL_US 1000
+#define TIMEOUT_US 60000000ULL
+
+static const char snippet[] =
+    "The quick brown fox jumps over the lazy dog. THE QUICK BROWN FOX!\n"
+    "\tbookkeeper, committee, aaa, 1000 + 2000 == 3000?\n"
+    " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~\n"
+    "No key for these: \x01\x7f\xc3\xa9 -- skipped.\n";
+
+static struct {
+    report_keyboard_t pending;
+    bool              full;
+    report_keyboard_t last; // last report the host read
+    uint32_t          sent;
+    uint32_t          lost;
+    char              typed[sizeof(snippet)];
+    size_t            typed_length;
+    uint64_t          last_char_us;
+} host;
+
+static void endpoint_write(const report_keyboard_t *report) {
+    if (host.full) {
+        host.lost++;
+    }
+    host.pending = *report;
+    host.full    = true;
+    host.sent++;
+}
+
+static char us_layout(uint8_t key, bool shifted, bool caps_lock) {
+    static const struct {
+        uint8_t key;
+        char    plain;
+        char    shifted;
+    } keys[] = {
+        {KC_1, '1', '!'},         {KC_2, '2', '@'},         {KC_3, '3', '#'},          {KC_4, '4', '$'},          {KC_5, '5', '%'},     {KC_6, '6', '^'},
+        {KC_7, '7', '&'},         {KC_8, '8', '*'},         {KC_9, '9', '('},          {KC_0, '0', ')'},          {KC_ENTER, '\n', 0},  {KC_TAB, '\t', 0},
+        {KC_SPACE, ' ', 0},       {KC_MINUS, '-', '_'},     {KC_EQUAL, '=', '+'},      {KC_LEFT_BRACKET, '[', '{'}, {KC_RIGHT_BRACKET, ']', '}'},
+        {KC_BACKSLASH, '\\', '|'}, {KC_SEMICOLON, ';', ':'}, {KC_QUOTE, '\'', '"'},     {KC_GRAVE, '`', '~'},      {KC_COMMA, ',', '<'}, {KC_DOT, '.', '>'},
+        {KC_SLASH, '/', '?'},
+    };
+    if (key >= KC_A && key <= KC_Z) {
+        return (shifted != caps_lock ? 'A' : 'a') + (key - KC_A);
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+        if (keys[i].key == key) {
+            return shifted && keys[i].shifted ? keys[i].shifted : keys[i].plain;
+        }
+    }
+    return '?';
+}
+
+static bool was_held(uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (host.last.keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Every key that went down since the last poll types its character.
+static void host_poll(void) {
+    if (!host.full) {
+        return;
+    }
+    host.full    = false;
+    bool shifted = host.pending.mods & MOD_BIT(KC_LEFT_SHIFT);
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = host.pending.keys[i];
+        if (key == KC_NO || was_held(key) || host.typed_length + 1 >= sizeof(host.typed)) {
+            continue;
+        }
+        host.typed[host.typed_length++] = us_layout(key, shifted, host_led_state.caps_lock);
+        host.last_char_us               = host_now_us();
+    }
+    host.last = host.pending;
+}
+
+static size_t expected_text(char *text) {
+    size_t length = 0;
+    for (const char *c = snippet; *c; c++) {
+        if ((*c >= ' ' && *c < 0x7F) || *c == '\n' || *c == '\t') {
+            text[length++] = *c;
+        }
+    }
+    text[length] = '\0';
+    return length;
+}
+
+// Pass times are drawn from [pass_min_us, pass_max_us]; the host's polls
+// start at a random phase against them.
+static bool run(uint32_t pass_min_us, uint32_t pass_max_us, bool caps_lock) {
+    memset(&host, 0, sizeof(host));
+    host_led_state.caps_lock = caps_lock;
+    host_keyboard_sink       = endpoint_write;
+
+    uint64_t start     = host_now_us();
+    uint64_t next_poll = start + rand() % POLL_US;
+    if (!macro_store_play(0)) {
+        printf("macro_store_play failed\n");
+        return false;
+    }
+    while ((macro_store_playing() || host.full) && host_now_us() - start < TIMEOUT_US) {
+        macro_store_task();
+        uint64_t pass_end = host_now_us() + pass_min_us + rand() % (pass_max_us - pass_min_us + 1);
+        while (next_poll <= pass_end) {
+            host_advance_us(next_poll - host_now_us());
+            host_poll();
+            next_poll += POLL_US;
+        }
+        host_advance_us(pass_end - host_now_us());
+    }
+
+    char   expected[sizeof(snippet)];
+    size_t length  = expected_text(expected);
+    bool   matches = host.typed_length == length && memcmp(host.typed, expected, length) == 0;
+    double seconds = (host.last_char_us - start) / 1e6;
+    printf("%5u-%-5u %-4s %6zu %8u %5u %9.0f  %s\n", pass_min_us, pass_max_us, caps_lock ? "on" : "off", host.typed_length, host.sent, host.lost, seconds > 0 ? host.typed_length / seconds : 0, matches ? "ok" : "MISMATCH");
+    if (!matches) {
+        printf("  typed: %.*s\n", (int)host.typed_length, host.typed);
+    }
+    return matches && host.lost == 0;
+}
+
+int main(void) {
+    static const uint32_t passes[][2] = {
+        {50, 150},   // scanning only
+        {200, 900},  // rendering between scans
+        {900, 1900}, // passes longer than a poll
+        {50, 3000},  // all of the above, mixed
+    };
+
+    srand(1);
+    host_flash_reset();
+    // Stored, then found again from flash as after a reset.
+    if (!macro_store_write(0, (const uint8_t *)snippet, strlen(snippet))) {
+        printf("macro_store_write failed\n");
+        return 1;
+    }
+    macro_store_load();
+    if (macro_store_length(0) != strlen(snippet)) {
+        printf("macro_store_load lost the snippet\n");
+        return 1;
+    }
+
+    bool ok = host_flash_stats.program_violations == 0;
+    printf("pass_us     caps  chars  reports  lost   chars/s\n");
+    for (size_t i = 0; i < ARRAY_SIZE(passes); i++) {
+        ok &= run(passes[i][0], passes[i][1], false);
+        ok &= run(passes[i][0], passes[i][1], true);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+#include "timer_wheel.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Runs utils/timer_wheel.c on the simulated millisecond clock, one
+// timer_wheel_task() per millisecond unless a test leaves a gap on purpose.
+// Every callback records when it ran, which has to be its deadline to the
+// millisecond, in deadline order, across the boundaries between the wheel's
+// levels, after long gaps and across the wrap of the 32-bit clock.
+//
+// Usage: timer_wheel_test
+
+#define MAX_FIRED 64
+
+typedef struct {
+    uint32_t             deadline;
+    uint32_t             period; // returned by the callback; 0 for one-shots
+    uint8_t              runs;   // runs before it returns 0
+    uint8_t              fired;
+    uint32_t             fired_at[8];
+    timer_wheel_handle_t handle;
+    bool                 cancel_self;
+} probe_t;
+
+static probe_t *fired_order[MAX_FIRED];
+static uint8_t  fired_count;
+
+static bool check(const char *name, bool ok) {
+    printf("%-52s %s\n", name, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static uint32_t probe_callback(void *arg) {
+    probe_t *probe = arg;
+    if (probe->fired < sizeof(probe->fired_at) / sizeof(probe->fired_at[0])) {
+        probe->fired_at[probe->fired] = timer_read32();
+    }
+    probe->fired++;
+    if (fired_count < MAX_FIRED) {
+        fired_order[fired_count++] = probe;
+    }
+    if (probe->cancel_self) {
+        timer_wheel_cancel(probe->handle);
+        return 1; // ignored once cancelled
+    }
+    return probe->fired < probe->runs ? probe->period : 0;
+}
+
+static void schedule(probe_t *probe, uint32_t delay_ms) {
+    probe->deadline = timer_read32() + (delay_ms ? delay_ms : 1);
+    probe->runs     = probe->runs ? probe->runs : 1;
+    probe->handle   = timer_wheel_schedule(delay_ms, probe_callback, probe);
+}
+
+static void run_ms(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        host_advance_us(1000);
+        timer_wheel_task();
+    }
+}
+
+// One pass after `ms`, as after a long gap.
+static void jump_ms(uint32_t ms) {
+    host_advance_us(ms * 1000U);
+    timer_wheel_task();
+}
+
+// The wheel may wake early, to move a timer down a level, but never after
+// the earliest deadline, and says 0 only when something is due.
+static bool next_deadline_ok(const probe_t *probes, uint8_t count) {
+    uint32_t now      = timer_read32();
+    uint32_t earliest = TIMER_WHEEL_NO_DEADLINE;
+    for (uint8_t i = 0; i < count; i++) {
+        if (timer_wheel_pending(probes[i].handle)) {
+            earliest = MIN(earliest, probes[i].deadline - now);
+        }
+    }
+    uint32_t next = timer_wheel_next_deadline();
+    if (earliest == TIMER_WHEEL_NO_DEADLINE) {
+        return next == TIMER_WHEEL_NO_DEADLINE;
+    }
+    return next <= earliest && next != TIMER_WHEEL_NO_DEADLINE;
+}
+
+// Delays either side of each level's span: 64 ms, 4.1 s and 4.4 min, and
+// past the top level's 4.66 h.
+static const uint32_t boundary_delays[] = {300000, 64, 0, 4097, 63, 262144, 4096, 1, 65, 262145, 4095, 262143, 16777300};
+
+static bool fired_in_order(void) {
+    for (uint8_t i = 1; i < fired_count; i++) {
+        if ((int32_t)(fired_order[i]->fired_at[0] - fired_order[i - 1]->fired_at[0]) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool test_level_boundaries(void) {
+    enum { COUNT = sizeof(boundary_delays) / sizeof(boundary_delays[0]) };
+    static probe_t probes[COUNT];
+    bool           exact = true, next_ok = true;
+
+    fired_count = 0;
+    for (uint8_t i = 0; i < COUNT; i++) {
+        schedule(&probes[i], boundary_delays[i]);
+    }
+    // 1 ms passes up to the 4.4 min timers, then straight to the last one.
+    for (uint32_t ms = 0; ms < 300001; ms++) {
+        next_ok &= next_deadline_ok(probes, COUNT);
+        run_ms(1);
+    }
+    // Only as far as the wheel says it next has work, which it has to
+    // reach on time.
+    while (probes[COUNT - 1].fired == 0) {
+        uint32_t next = timer_wheel_next_deadline();
+        next_ok &= next_deadline_ok(probes, COUNT);
+        jump_ms(next ? MIN(next, 4000000) : 1);
+    }
+    for (uint8_t i = 0; i < COUNT; i++) {
+        exact &= probes[i].fired == 1 && probes[i].fired_at[0] == probes[i].deadline;
+    }
+    bool ok = true;
+    ok &= check("every timer at its deadline across level boundaries", exact);
+    ok &= check("fired in deadline order", fired_in_order() && fired_count == COUNT);
+    ok &= check("next deadline never after the earliest one", next_ok);
+    return ok;
+}
+
+static bool test_cancel(void) {
+    static probe_t first, second, kept;
+    bool           ok = true;
+
+    schedule(&first, 5);
+    schedule(&kept, 20);
+    ok &= check("cancel a pending timer", timer_wheel_cancel(kept.handle) && !timer_wheel_pending(kept.handle));
+    run_ms(30);
+    ok &= check("a cancelled timer never fires", kept.fired == 0 && first.fired == 1);
+
+    // The finished timer's place is free again and goes to the next one.
+    timer_wheel_handle_t stale = first.handle;
+    schedule(&second, 5);
+    ok &= check("stale handle cancels nothing once its place is reused", (second.handle & 0xFF) == (stale & 0xFF) && !timer_wheel_cancel(stale) && timer_wheel_pending(second.handle));
+    ok &= check("second cancel of the same handle fails", timer_wheel_cancel(second.handle) && !timer_wheel_cancel(second.handle));
+    run_ms(10);
+    ok &= check("nothing fires after the cancels", second.fired == 0);
+    return ok;
+}
+
+static probe_t  chained;
+static uint32_t chain_callback(void *arg) {
+    (void)arg;
+    schedule(&chained, 0);
+    return 0;
+}
+
+static bool test_reschedule(void) {
+    static probe_t repeating, self;
+    bool           ok = true;
+
+    repeating.period = 10;
+    repeating.runs   = 5;
+    schedule(&repeating, 10);
+    uint32_t start = timer_read32();
+    run_ms(100);
+    bool exact = repeating.fired == 5;
+    for (uint8_t i = 0; i < 5; i++) {
+        exact &= repeating.fired_at[i] == start + 10 * (i + 1);
+    }
+    ok &= check("repeating timer every 10 ms, 5 runs", exact && !timer_wheel_pending(repeating.handle));
+
+    self.cancel_self = true;
+    schedule(&self, 3);
+    run_ms(20);
+    ok &= check("callback cancelling itself is not run again", self.fired == 1 && !timer_wheel_pending(self.handle));
+
+    // A timer scheduled from a callback runs on the next millisecond.
+    uint32_t at = timer_read32() + 7;
+    timer_wheel_schedule(7, chain_callback, NULL);
+    run_ms(10);
+    ok &= check("timer scheduled from a callback", chained.fired == 1 && chained.fired_at[0] == at + 1);
+    return ok;
+}
+
+// USB suspend or a long flash erase: one pass after a long time catches up
+// in one go, in deadline order, and the wheel is exact again afterwards.
+static bool test_long_gap(void) {
+    static const uint32_t delays[] = {70000, 5, 5000, 100, 262150};
+    enum { COUNT = sizeof(delays) / sizeof(delays[0]) };
+    static probe_t probes[COUNT];
+    static probe_t after;
+    bool           all = true, ok = true;
+
+    fired_count = 0;
+    for (uint8_t i = 0; i < COUNT; i++) {
+        schedule(&probes[i], delays[i]);
+    }
+    uint32_t start = timer_read32();
+    jump_ms(300000);
+    for (uint8_t i = 0; i < COUNT; i++) {
+        all &= probes[i].fired == 1 && probes[i].fired_at[0] == start + 300000;
+    }
+    ok &= check("one pass after 5 min runs everything due", all && fired_count == COUNT);
+    bool order = true;
+    for (uint8_t i = 1; i < fired_count; i++) {
+        order &= (int32_t)(fired_order[i]->deadline - fired_order[i - 1]->deadline) >= 0;
+    }
+    ok &= check("caught up in deadline order", order);
+
+    schedule(&after, 70);
+    run_ms(80);
+    ok &= check("exact again after the gap", after.fired == 1 && after.fired_at[0] == after.deadline);
+    return ok;
+}
+
+static bool test_wrap(void) {
+    static const uint32_t delays[] = {20, 49, 50, 51, 100, 4200, 70000};
+    enum { COUNT = sizeof(delays) / sizeof(delays[0]) };
+    static probe_t probes[COUNT];
+    bool           exact = true, next_ok = true, ok = true;
+
+    // Up to 50 ms before timer_read32() wraps, a long gap at a time.
+    while (UINT32_MAX - timer_read32() > 4000000) {
+        jump_ms(4000000);
+    }
+    jump_ms(UINT32_MAX - timer_read32() - 49);
+
+    fired_count = 0;
+    for (uint8_t i = 0; i < COUNT; i++) {
+        schedule(&probes[i], delays[i]);
+    }
+    for (uint32_t ms = 0; ms <= 70000; ms++) {
+        next_ok &= next_deadline_ok(probes, COUNT);
+        run_ms(1);
+    }
+    for (uint8_t i = 0; i < COUNT; i++) {
+        exact &= probes[i].fired == 1 && probes[i].fired_at[0] == probes[i].deadline;
+    }
+    ok &= check("exact deadlines across the 32-bit wrap", exact && timer_read32() < 100000);
+    ok &= check("fired in deadline order across the wrap", fired_in_order() && fired_count == COUNT);
+    ok &= check("next deadline never after the earliest one", next_ok);
+    return ok;
+}
+
+int main(void) {
+    bool ok = true;
+
+    // A clock that does not start at 0, as after a soft reset.
+    host_advance_us(123456789);
+    ok &= check("nothing scheduled", timer_wheel_next_deadline() == TIMER_WHEEL_NO_DEADLINE);
+    ok &= test_level_boundaries();
+    ok &= test_cancel();
+    ok &= test_reschedule();
+    ok &= test_long_gap();
+    ok &= test_wrap();
+
+    return ok ? 0 : 1;
+}
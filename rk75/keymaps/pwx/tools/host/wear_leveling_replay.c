@@ -0,0 +1,209 @@
+#include "wear_leveling_metrics.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "boot_profile.h"
+#include "wear_leveling.h"
+
+// Replays EEPROM writes through QMK's wear-leveling core and the keymap's
+// backing store (utils/wear_leveling_metrics.c) onto a flash image, then
+// prints the metrics the keyboard would report over raw HID.
+//
+//   wear_leveling_replay [-i image] [-t trace] [-n writes] [-r every]
+//
+// -i keeps the flash in an image file between runs, memory-mapped; without
+// it a scratch file is used. -t reads writes from a trace, one per line as
+// "<address> <hex bytes>" with '#' comments; without it -n writes (default
+// 5000) of a VIA-like mix are generated. Every -r writes (default 100) the
+// board is "rebooted": the core is mounted again from flash, which must give
+// back exactly what was written. Flash timing follows a W25Q-class part.
+
+void boot_profile_mark(boot_mark_t mark) {}
+
+static uint8_t  shadow[WEAR_LEVELING_LOGICAL_SIZE];
+static uint32_t logical_writes;
+static uint32_t logical_bytes;
+static bool     failed;
+
+static void write_logical(uint32_t address, const uint8_t *bytes, size_t length) {
+    if (address + length > sizeof(shadow)) {
+        printf("write at %u+%zu is past the logical size\n", address, length);
+        failed = true;
+        return;
+    }
+    memcpy(&shadow[address], bytes, length);
+    if (wear_leveling_write(address, bytes, length) == WEAR_LEVELING_FAILED) {
+        printf("wear_leveling_write failed at %u+%zu\n", address, length);
+        failed = true;
+    }
+    logical_writes++;
+    logical_bytes += length;
+}
+
+static void verify(const char *when) {
+    static uint8_t image[WEAR_LEVELING_LOGICAL_SIZE];
+    if (wear_leveling_read(0, image, sizeof(image)) == WEAR_LEVELING_FAILED || memcmp(image, shadow, sizeof(image)) != 0) {
+        printf("contents differ from what was written %s\n", when);
+        failed = true;
+    }
+}
+
+static void reboot(void) {
+    if (wear_leveling_init() == WEAR_LEVELING_FAILED) {
+        printf("wear_leveling_init failed\n");
+        failed = true;
+    }
+    verify("after a reboot");
+}
+
+// Roughly what VIA and the keymap save: keymap edits (one keycode), lighting
+// changes (a few bytes of rgb config), toggles (one byte) and now and then a
+// whole macro buffer.
+static void generate(uint32_t writes, uint32_t reboot_every) {
+    for (uint32_t i = 0; i < writes && !failed; i++) {
+        uint8_t  bytes[64];
+        uint32_t address;
+        size_t   length;
+        uint32_t kind = rand() % 100;
+        if (kind < 60) {
+            length  = 2;
+            address = 64 + (rand() % 540) * 2;
+        } else if (kind < 85) {
+            length  = 4;
+            address = 24;
+        } else if (kind < 97) {
+            length  = 1;
+            address = 32 + rand() % 16;
+        } else {
+            length  = sizeof(bytes);
+            address = sizeof(shadow) - 512 + (rand() % 8) * sizeof(bytes);
+        }
+        for (size_t b = 0; b < length; b++) {
+            bytes[b] = rand();
+        }
+        write_logical(address, bytes, length);
+        if (reboot_every && (i + 1) % reboot_every == 0) {
+            reboot();
+        }
+    }
+}
+
+static void replay(FILE *trace, uint32_t reboot_every) {
+    char     line[1024];
+    uint32_t count = 0;
+    while (fgets(line, sizeof(line), trace) && !failed) {
+        char *text = line;
+        char *end;
+        while (*text == ' ' || *text == '\t') {
+            text++;
+        }
+        if (*text == '#' || *text == '\n' || *text == '\0') {
+            continue;
+        }
+        uint32_t address = strtoul(text, &end, 0);
+        uint8_t  bytes[sizeof(line) / 2];
+        size_t   length = 0;
+        for (text = end; length < sizeof(bytes);) {
+            while (*text == ' ' || *text == '\t') {
+                text++;
+            }
+            unsigned value;
+            int      used;
+            if (sscanf(text, "%2x%n", &value, &used) != 1) {
+                break;
+            }
+            bytes[length++] = value;
+            text += used;
+        }
+        if (text == end || length == 0) {
+            printf("bad trace line: %s", line);
+            failed = true;
+            break;
+        }
+        write_logical(address, bytes, length);
+        count++;
+        if (reboot_every && count % reboot_every == 0) {
+            reboot();
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *image   = NULL;
+    const char *trace   = NULL;
+    uint32_t    writes  = 5000;
+    uint32_t    every   = 100;
+    for (int opt; (opt = getopt(argc, argv, "i:t:n:r:")) != -1;) {
+        switch (opt) {
+            case 'i':
+                image = optarg;
+                break;
+            case 't':
+                trace = optarg;
+                break;
+            case 'n':
+                writes = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                every = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-i image] [-t trace] [-n writes] [-r every]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    char scratch[] = "/tmp/wear_leveling_XXXXXX";
+    if (!image) {
+        int fd = mkstemp(scratch);
+        if (fd < 0) {
+            perror("mkstemp");
+            return 1;
+        }
+        close(fd);
+        image = scratch;
+    }
+    bool mapped = host_flash_map(image);
+    if (image == scratch) {
+        unlink(scratch);
+    }
+    if (!mapped) {
+        fprintf(stderr, "%s: cannot map a %u byte flash image\n", image, EXTERNAL_FLASH_SIZE);
+        return 1;
+    }
+    host_flash_timing = (host_flash_timing_t){.program_us = 400, .erase_sector_us = 45000, .erase_block_us = 150000};
+
+    srand(1);
+    reboot();
+    memset(&wear_leveling_metrics, 0, sizeof(wear_leveling_metrics));
+    if (trace) {
+        FILE *file = fopen(trace, "r");
+        if (!file) {
+            fprintf(stderr, "%s: %s\n", trace, strerror(errno));
+            return 1;
+        }
+        replay(file, every);
+        fclose(file);
+    } else {
+        generate(writes, every);
+    }
+    reboot();
+
+    wear_leveling_metrics_t *m = &wear_leveling_metrics;
+    printf("backing %u bytes, logical %u, %u-byte words\n", WEAR_LEVELING_BACKING_SIZE, WEAR_LEVELING_LOGICAL_SIZE, BACKING_STORE_WRITE_SIZE);
+    printf("writes          %10u (%u bytes)\n", logical_writes, logical_bytes);
+    printf("log appends     %10u\n", m->log_appends);
+    printf("bulk writes     %10u\n", m->bulk_writes);
+    printf("programmed      %10u bytes, %.2fx the bytes written\n", m->programmed, logical_bytes ? (double)m->programmed / logical_bytes : 0);
+    printf("compactions     %10u\n", m->compactions);
+    printf("sector erases   %10u (%.1f per sector per 1000 writes)\n", m->sector_erases, logical_writes ? m->sector_erases * 1000.0 / logical_writes / (WEAR_LEVELING_BACKING_SIZE / EXTERNAL_FLASH_SECTOR_SIZE) : 0);
+    printf("blocked         %10.1f ms, longest %.1f ms\n", m->blocked_us / 1000.0, m->max_blocked_us / 1000.0);
+    printf("failures        %10u\n", m->failures);
+    if (host_flash_stats.program_violations) {
+        printf("programs that needed an erase first: %u\n", host_flash_stats.program_violations);
+    }
+    return failed || m->failures || host_flash_stats.program_violations ? 1 : 0;
+}
@@ -0,0 +1,300 @@
+#!/usr/bin/env python3
+"""Stream live lighting to the keyboard over raw HID.
+
+Host side of utils/light_stream.c. Every frame is encoded in whichever way
+takes the fewest 32-byte reports, given what the keyboard already shows:
+
+  FULL     the 8-LED blocks that changed, 8 LEDs per report
+  DELTA    the changed LEDs, 6 per report
+  INDEXED  frames of at most 16 colours: palette updates (8 colours per
+           report) plus the 50-LED blocks that changed, 50 LEDs per report
+
+The last report of a frame carries the SHOW flag. Frames that change nothing
+send nothing, except for a keep-alive that stops the stream from timing out.
+
+Sources:
+
+  rainbow  a hue sweep across the board
+  alert    the whole board flashing red at 2 Hz, dark in between
+  screen   the colour of the screen area under each key (needs Pillow)
+
+With --loopback no keyboard is needed. The reports go into a model of the
+firmware decoder, every decoded frame is checked against its source, and the
+report budget is compared with the one report per millisecond that the USB
+endpoint carries. Otherwise the keyboard is opened with hidapi (the 'hid'
+module) on the VIA raw HID interface, and its counters are read at the end.
+
+Usage: light_stream.py [--source NAME] [--fps N] [--seconds N] [--loopback]
+"""
+
+import argparse
+import colorsys
+import json
+import math
+import time
+from pathlib import Path
+
+REPORT_SIZE = 32
+PWX_HID_COMMAND_ID = 0xA0
+PWX_HID_LIGHT_STREAM = 0x0C
+OP_INFO, OP_FULL, OP_DELTA, OP_PALETTE, OP_INDEXED, OP_STOP, OP_STATS, OP_RESET = range(8)
+FLAG_SHOW = 0x01
+
+PALETTE_SIZE = 16
+FULL_PER_REPORT = 8
+DELTA_PER_REPORT = 6
+PALETTE_PER_REPORT = 8
+INDEXED_PER_REPORT = 50
+KEEPALIVE_S = 0.4  # well inside LIGHT_STREAM_TIMEOUT_MS
+REPORTS_PER_SECOND = 1000  # one per 1 ms USB poll
+
+VIA_USAGE_PAGE = 0xFF60
+VIA_USAGE = 0x61
+
+KEYBOARD_JSON = Path(__file__).resolve().parents[3] / 'keyboard.json'
+
+
+def load_board(path):
+    with open(path, encoding='utf-8') as f:
+        info = json.load(f)
+    leds = [(led['x'], led['y']) for led in info['rgb_matrix']['layout']]
+    return leds, int(info['usb']['vid'], 16), int(info['usb']['pid'], 16)
+
+
+def report(op, body):
+    data = bytes([PWX_HID_COMMAND_ID, PWX_HID_LIGHT_STREAM, op]) + bytes(body)
+    assert len(data) <= REPORT_SIZE
+    return data + bytes(REPORT_SIZE - len(data))
+
+
+def rgb(color):
+    return [(color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF]
+
+
+class Encoder:
+    """Turns frames of 0xRRGGBB ints into reports, tracking the device state."""
+
+    def __init__(self, led_count):
+        self.shown = [None] * led_count  # unknown until sent
+        self.palette = [None] * PALETTE_SIZE
+        self.seq = 0
+        self.last_sent = -math.inf
+        self.used = {'full': 0, 'delta': 0, 'indexed': 0, 'keepalive': 0}
+
+    def _full(self, frame, changed):
+        packets = []
+        for block in sorted({i // FULL_PER_REPORT for i in changed}):
+            first = block * FULL_PER_REPORT
+            leds = frame[first:first + FULL_PER_REPORT]
+            packets.append((OP_FULL, [first, len(leds)] + [c for color in leds for c in rgb(color)]))
+        return packets, None
+
+    def _delta(self, frame, changed):
+        packets = []
+        for start in range(0, len(changed), DELTA_PER_REPORT):
+            leds = changed[start:start + DELTA_PER_REPORT]
+            packets.append((OP_DELTA, [len(leds)] + [v for i in leds for v in [i] + rgb(frame[i])]))
+        return packets, None
+
+    def _indexed(self, frame, changed):
+        colors = set(frame)
+        if len(colors) > PALETTE_SIZE:
+            return None, None
+        palette = list(self.palette)
+        missing = [color for color in colors if color not in palette]
+        free = [slot for slot, color in enumerate(palette) if color not in colors]
+        for color, slot in zip(missing, free):
+            palette[slot] = color
+        packets = []
+        dirty = sorted(slot for slot in range(PALETTE_SIZE) if palette[slot] != self.palette[slot])
+        while dirty:
+            first = dirty[0]
+            run = [slot for slot in dirty if slot < first + PALETTE_PER_REPORT]
+            count = run[-1] - first + 1
+            packets.append((OP_PALETTE, [first, count] + [c for slot in range(first, first + count) for c in rgb(palette[slot] or 0)]))
+            dirty = dirty[len(run):]
+        index = {color: palette.index(color) for color in colors}
+        for block in sorted({i // INDEXED_PER_REPORT for i in changed}):
+            first = block * INDEXED_PER_REPORT
+            leds = frame[first:first + INDEXED_PER_REPORT]
+            nibbles = [index[color] for color in leds] + [0]
+            packed = [nibbles[i] | nibbles[i + 1] << 4 for i in range(0, len(leds), 2)]
+            packets.append((OP_INDEXED, [first, len(leds)] + packed))
+        return packets, palette
+
+    def encode(self, frame, now):
+        changed = [i for i, color in enumerate(frame) if color != self.shown[i]]
+        if not changed:
+            if now - self.last_sent < KEEPALIVE_S:
+                return []
+            self.used['keepalive'] += 1
+            plan, palette, kind = [(OP_DELTA, [0])], None, None
+        else:
+            options = [(self._full(frame, changed), 'full'), (self._delta(frame, changed), 'delta'),
+                       (self._indexed(frame, changed), 'indexed')]
+            (plan, palette), kind = min((option for option in options if option[0][0] is not None),
+                                        key=lambda option: len(option[0][0]))
+            self.used[kind] += 1
+        if palette is not None:
+            self.palette = palette
+        self.shown = list(frame)
+        self.last_sent = now
+        reports = []
+        for n, (op, body) in enumerate(plan):
+            flags = FLAG_SHOW if n == len(plan) - 1 else 0
+            reports.append(report(op, [self.seq & 0xFF, flags] + body))
+            self.seq += 1
+        return reports
+
+
+class Loopback:
+    """Mirrors frame_packet() in utils/light_stream.c."""
+
+    def __init__(self, led_count):
+        self.frame = [0] * led_count
+        self.palette = [0] * PALETTE_SIZE
+        self.shown = None
+        self.next_seq = None
+        self.stats = {'packets': 0, 'frames': 0, 'lost': 0, 'rejected': 0, 'stale': 0}
+
+    def send(self, data):
+        assert data[0] == PWX_HID_COMMAND_ID and data[1] == PWX_HID_LIGHT_STREAM
+        op, seq, flags, body = data[2], data[3], data[4], data[5:]
+        ahead = (seq - self.next_seq) & 0xFF if self.next_seq is not None else 0
+        if ahead >= 0x80:
+            self.stats['packets'] += 1
+            self.stats['stale'] += 1
+            return
+        color = lambda at: body[at] << 16 | body[at + 1] << 8 | body[at + 2]
+        if op in (OP_FULL, OP_PALETTE):
+            target = self.frame if op == OP_FULL else self.palette
+            first, count = body[0], body[1]
+            ok = first + count <= len(target)
+            for i in range(count if ok else 0):
+                target[first + i] = color(2 + i * 3)
+        elif op == OP_DELTA:
+            leds = [(body[1 + i * 4], color(2 + i * 4)) for i in range(body[0])]
+            ok = all(led < len(self.frame) for led, _ in leds)
+            for led, value in leds if ok else []:
+                self.frame[led] = value
+        else:
+            first, count = body[0], body[1]
+            ok = first + count <= len(self.frame)
+            for i in range(count if ok else 0):
+                self.frame[first + i] = self.palette[(body[2 + i // 2] >> (4 * (i & 1))) & 0x0F]
+        self.stats['lost'] += ahead
+        self.next_seq = (seq + 1) & 0xFF
+        self.stats['packets'] += 1
+        if not ok:
+            self.stats['rejected'] += 1
+        elif flags & FLAG_SHOW:
+            self.shown = list(self.frame)
+            self.stats['frames'] += 1
+
+    def close(self):
+        return self.stats
+
+
+class HidLink:
+    def __init__(self, vid, pid):
+        import hid  # hidapi bindings; only needed for a real keyboard
+
+        paths = [d['path'] for d in hid.enumerate(vid, pid) if d['usage_page'] == VIA_USAGE_PAGE and d['usage'] == VIA_USAGE]
+        if not paths:
+            raise SystemExit(f'no raw HID interface for {vid:04x}:{pid:04x}')
+        self.device = hid.device()
+        self.device.open_path(paths[0])
+        self.device.set_nonblocking(True)
+        self.request(OP_RESET)
+
+    def send(self, data):
+        self.device.write(b'\0' + data)
+        while self.device.read(REPORT_SIZE):
+            pass  # acknowledgements; only the counters matter
+
+    def request(self, op):
+        self.device.set_nonblocking(False)
+        self.device.write(b'\0' + report(op, []))
+        deadline = time.monotonic() + 1
+        while time.monotonic() < deadline:
+            reply = bytes(self.device.read(REPORT_SIZE, 100))
+            if reply[:3] == bytes([PWX_HID_COMMAND_ID, PWX_HID_LIGHT_STREAM, op]):
+                self.device.set_nonblocking(True)
+                return reply[3:]
+        raise SystemExit('keyboard did not answer')
+
+    def close(self):
+        stats = self.request(OP_STATS)
+        self.request(OP_STOP)
+        names = ('packets', 'frames', 'lost', 'rejected', 'bytes', 'active_ms', 'stale')
+        return {name: int.from_bytes(stats[1 + i * 4:5 + i * 4], 'little') for i, name in enumerate(names)}
+
+
+def rainbow(leds, t):
+    return [pixel(*colorsys.hsv_to_rgb((x / 224 + t / 4) % 1, 1, 1)) for x, _ in leds]
+
+
+def alert(leds, t):
+    return [0xFF0000 if (t * 2) % 1 < 0.5 else 0] * len(leds)
+
+
+def screen_source():
+    from PIL import ImageGrab  # Pillow; only needed for this source
+
+    def sample(leds, t):
+        image = ImageGrab.grab().convert('RGB').resize((225, 65))
+        return [pixel(*(c / 255 for c in image.getpixel((x, y)))) for x, y in leds]
+
+    return sample
+
+
+def pixel(r, g, b):
+    return round(r * 255) << 16 | round(g * 255) << 8 | round(b * 255)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--source', choices=('rainbow', 'alert', 'screen'), default='rainbow')
+    parser.add_argument('--fps', type=float, default=60)
+    parser.add_argument('--seconds', type=float, default=10)
+    parser.add_argument('--loopback', action='store_true', help='decode locally instead of sending to a keyboard')
+    parser.add_argument('--keyboard-json', default=KEYBOARD_JSON)
+    args = parser.parse_args()
+
+    leds, vid, pid = load_board(args.keyboard_json)
+    source = {'rainbow': rainbow, 'alert': alert}.get(args.source) or screen_source()
+    link = Loopback(len(leds)) if args.loopback else HidLink(vid, pid)
+    encoder = Encoder(len(leds))
+
+    frames = args.fps * args.seconds
+    per_frame = []
+    sent = 0
+    start = time.monotonic()
+    for n in range(int(frames)):
+        t = n / args.fps
+        if not args.loopback:
+            time.sleep(max(0, start + t - time.monotonic()))
+        frame = source(leds, t)
+        reports = encoder.encode(frame, t)
+        for data in reports:
+            link.send(data)
+        sent += sum(len(data) for data in reports)
+        per_frame.append(len(reports))
+        if args.loopback and reports and link.frame != frame:
+            raise SystemExit(f'frame {n}: decoded frame differs from the source')
+    elapsed = args.seconds if args.loopback else time.monotonic() - start
+    stats = link.close()
+
+    peak = max(per_frame, default=0)
+    print(f'{len(per_frame)} frames in {elapsed:.2f} s ({len(per_frame) / elapsed:.1f} fps), '
+          f'{sum(per_frame)} reports, {sent / elapsed / 1000:.1f} kB/s')
+    print(f'reports per frame: mean {sum(per_frame) / max(len(per_frame), 1):.2f}, max {peak}; '
+          f'encodings {", ".join(f"{k} {v}" for k, v in encoder.used.items())}')
+    print(f'peak link load at {args.fps:g} fps: {peak * args.fps / REPORTS_PER_SECOND:.0%} of {REPORTS_PER_SECOND} reports/s')
+    print('device: ' + ', '.join(f'{k} {v}' for k, v in stats.items()))
+    if args.loopback:
+        print('loopback: every decoded frame matched its source')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""Decode the keymap's UART3 event trace into a timeline.
+
+The firmware (utils/event_trace.c, built with EVENT_TRACE_ENABLE=yes) sends
+8-byte records [0xA5, type, arg (u16 LE), cycles (u32 LE)] at 2 Mbaud, 8N1.
+Capture the raw bytes with any serial tool, for example
+
+  stty -F /dev/ttyUSB0 2000000 raw && cat /dev/ttyUSB0 > trace.bin
+
+and decode the file afterwards. Timestamps are DWT cycles; the 32-bit counter
+wraps every ~44 s at 96 MHz. The firmware sends a heartbeat record every 10 s
+so that no two records are further apart than that, and the counter is
+unwrapped from one record to the next. When records were lost on the way,
+the seconds since boot carried by the next heartbeat put the timeline back in
+place; a heartbeat whose seconds go backwards means the board was reset.
+
+Each line shows the time since the first record, the time since the previous
+one and the decoded event. Debounced key events and reports also show how long
+after the matching matrix edge (or the last key event) they happened, and a
+latency summary follows the timeline. Key events are followed by their age:
+the microseconds between the scan sampling the change and its processing.
+
+Usage: trace_decode.py [--hz HZ] <capture file | ->
+"""
+
+import argparse
+import statistics
+import sys
+
+SYNC = 0xA5
+RECORD_SIZE = 8
+
+MATRIX_EDGE = 0x01
+KEY_EVENT = 0x02
+SOCD = 0x03
+REPORT = 0x04
+FRAME = 0x05
+FLASH = 0x06
+KEY_AGE = 0x07
+HEARTBEAT = 0x08
+OVERFLOW = 0x7F
+TYPES = {MATRIX_EDGE, KEY_EVENT, SOCD, REPORT, FRAME, FLASH, KEY_AGE, HEARTBEAT, OVERFLOW}
+WRAP = 1 << 32
+
+FLASH_SOURCES = ('wear-leveling', 'usage-stats', 'macro-store')
+FLASH_OPS = ('program', 'erase')
+
+
+def is_header(data, i):
+    return data[i] == SYNC and data[i + 1] in TYPES
+
+
+def moves_forward(previous, cycles):
+    return (cycles - previous) % WRAP < WRAP // 2
+
+
+def records(data):
+    """Yields (type, arg, cycles), skipping bytes until the stream is in sync.
+
+    Out of sync, a position counts as a record boundary when it starts with
+    the sync byte and a known type, and the record after it does too (or the
+    data ends). Right after an accepted record, a record whose header is
+    valid is taken even when garbage follows it, as long as its timestamp
+    does not go backwards: a byte lost on the line then costs the record it
+    hit, not the one before it as well.
+    """
+    skipped = 0
+    previous = None  # cycles of the record that ended at i
+    i = 0
+    while i + RECORD_SIZE <= len(data):
+        if is_header(data, i):
+            j = i + RECORD_SIZE
+            cycles = int.from_bytes(data[i + 4:j], 'little')
+            confirmed = j + 1 >= len(data) or is_header(data, j)
+            if confirmed or (previous is not None and moves_forward(previous, cycles)):
+                if skipped:
+                    print(f'# skipped {skipped} bytes to resynchronise', file=sys.stderr)
+                    skipped = 0
+                yield data[i + 1], data[i + 2] | data[i + 3] << 8, cycles
+                previous = cycles
+                i = j
+                continue
+        skipped += 1
+        previous = None
+        i += 1
+
+
+def key_position(arg):
+    return (arg >> 8) & 0x7F, arg & 0xFF
+
+
+def describe(kind, arg):
+    if kind in (MATRIX_EDGE, KEY_EVENT):
+        row, col = key_position(arg)
+        name = 'edge' if kind == MATRIX_EDGE else 'key'
+        return f'{name:6} r{row} c{col} {"down" if arg & 0x8000 else "up"}'
+    if kind == SOCD:
+        keycode = arg & 0xFF
+        if arg & 0x4000:
+            return f'socd   swallow 0x{keycode:02X}'
+        return f'socd   {"press" if arg & 0x8000 else "release"} 0x{keycode:02X}'
+    if kind == REPORT:
+        return 'report'
+    if kind == FRAME:
+        return 'frame  sent' if arg else 'frame  unchanged'
+    if kind == FLASH:
+        source, op = arg >> 8, arg & 0xFF
+        source = FLASH_SOURCES[source] if source < len(FLASH_SOURCES) else f'source {source}'
+        op = FLASH_OPS[op] if op < len(FLASH_OPS) else f'op {op}'
+        return f'flash  {source} {op}'
+    if kind == KEY_AGE:
+        return f'age    {arg}{"+" if arg == 0xFFFF else ""} us since sampled'
+    if kind == HEARTBEAT:
+        return f'alive  {arg} s since boot'
+    return f'OVERFLOW {arg} records dropped'
+
+
+def summarise(name, samples):
+    if not samples:
+        return
+    samples = sorted(samples)
+    p99 = samples[min(len(samples) - 1, int(len(samples) * 0.99))]
+    print(f'# {name:20} n={len(samples):<6} min={samples[0]:9.1f} '
+          f'median={statistics.median(samples):9.1f} p99={p99:9.1f} max={samples[-1]:9.1f} us')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--hz', type=float, default=96e6, help='cycle counter frequency (default 96 MHz)')
+    parser.add_argument('capture', help='raw capture file, or - for stdin')
+    args = parser.parse_args()
+
+    if args.capture == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, 'rb') as f:
+            data = f.read()
+
+    us_per_cycle = 1e6 / args.hz
+    first = previous = None
+    epoch = 0
+    last_raw = None
+    anchor = None  # (seconds, unwrapped cycles) of the last heartbeat
+    pending_edges = {}  # (row, col, pressed) -> time of the raw edge
+    last_key = None
+    edge_to_key = []
+    sample_to_key = []
+    key_to_report = []
+
+    for kind, arg, cycles in records(data):
+        if last_raw is not None and cycles < last_raw:
+            epoch += WRAP
+        last_raw = cycles
+        if kind == HEARTBEAT:
+            if anchor is not None and (arg - anchor[0]) % 0x10000 >= 0x8000:
+                print(f'# board reset: {arg} s since boot after {anchor[0]} s', file=sys.stderr)
+            elif anchor is not None:
+                expected = anchor[1] + (arg - anchor[0]) % 0x10000 * args.hz
+                wraps = round((expected - epoch - cycles) / WRAP)
+                if wraps:
+                    print(f'# {wraps:+d} counter wraps restored from the heartbeat', file=sys.stderr)
+                    epoch += wraps * WRAP
+            anchor = (arg, epoch + cycles)
+        t = (epoch + cycles) * us_per_cycle
+        if first is None:
+            first = previous = t
+
+        note = ''
+        if kind == MATRIX_EDGE:
+            pending_edges[(*key_position(arg), bool(arg & 0x8000))] = t
+        elif kind == KEY_EVENT:
+            edge = pending_edges.pop((*key_position(arg), bool(arg & 0x8000)), None)
+            if edge is not None:
+                edge_to_key.append(t - edge)
+                note = f'  (edge +{t - edge:.1f} us)'
+            last_key = t
+        elif kind == KEY_AGE:
+            sample_to_key.append(arg)
+        elif kind == REPORT and last_key is not None:
+            key_to_report.append(t - last_key)
+            note = f'  (key +{t - last_key:.1f} us)'
+            last_key = None
+        elif kind == OVERFLOW:
+            pending_edges.clear()
+            last_key = None
+
+        print(f'{t - first:14.1f} {t - previous:+12.1f}  {describe(kind, arg)}{note}')
+        previous = t
+
+    summarise('edge -> key event', edge_to_key)
+    summarise('sample -> key event', sample_to_key)
+    summarise('key event -> report', key_to_report)
+
+
+if __name__ == '__main__':
+    main()
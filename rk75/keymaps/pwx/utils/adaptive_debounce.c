@@ -0,0 +1,192 @@
+#include "adaptive_debounce.h"
+
+#include <string.h>
+#include "debounce.h"
+#include "hid_commands.h"
+#include "key_time.h"
+#include "matrix_scan.h"
+
+_Static_assert(ADAPTIVE_DEBOUNCE_BASE_MS > 0 && ADAPTIVE_DEBOUNCE_BASE_MS < ADAPTIVE_DEBOUNCE_CHATTER_MS, "adaptive_debounce: the chatter threshold must exceed the base window");
+_Static_assert(ADAPTIVE_DEBOUNCE_MAX_MS >= ADAPTIVE_DEBOUNCE_BASE_MS && ADAPTIVE_DEBOUNCE_MAX_MS <= UINT8_MAX, "adaptive_debounce: bad maximum window");
+
+#define KEY_COUNT (MATRIX_ROWS * MATRIX_COLS)
+#define MS_TO_US(ms) ((uint32_t)(ms) * 1000)
+
+static uint8_t  window_ms[MATRIX_ROWS][MATRIX_COLS];
+static uint16_t chatter[MATRIX_ROWS][MATRIX_COLS];
+// Sample times in microseconds (key_time.h), so a window ends on the first
+// scan after it really has rather than on a millisecond tick.
+static uint32_t changed_at[MATRIX_ROWS][MATRIX_COLS];     // last reported change
+static uint32_t released_since[MATRIX_ROWS][MATRIX_COLS]; // start of a deferred release
+
+// Keys still inside their window or waiting on a deferred release; the only
+// ones that need looking at on a scan where the raw matrix did not change.
+static matrix_row_t busy[MATRIX_ROWS];
+static matrix_row_t deferring[MATRIX_ROWS];
+static matrix_row_t eager[MATRIX_ROWS];
+
+static void count_chatter(uint8_t row, uint8_t col) {
+    if (chatter[row][col] != UINT16_MAX) {
+        chatter[row][col]++;
+    }
+}
+
+void debounce_init(uint8_t num_rows) {
+    uint32_t now = key_time_now_us();
+    memset(window_ms, ADAPTIVE_DEBOUNCE_BASE_MS, sizeof(window_ms));
+    memset(chatter, 0, sizeof(chatter));
+    memset(busy, 0, sizeof(busy));
+    memset(deferring, 0, sizeof(deferring));
+    memset(eager, 0, sizeof(eager));
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            // Far enough back that the first press is neither locked out nor chatter.
+            changed_at[row][col] = now - MS_TO_US(ADAPTIVE_DEBOUNCE_CHATTER_MS);
+        }
+    }
+}
+
+// Returns true when the reported state of the key changes.
+static bool update_key(uint8_t row, uint8_t col, bool pressed, matrix_row_t *cooked_row, uint32_t now) {
+    matrix_row_t mask     = MATRIX_ROW_SHIFTER << col;
+    bool         is_eager = eager[row] & mask;
+    uint8_t      window   = is_eager ? ADAPTIVE_DEBOUNCE_BASE_MS : window_ms[row][col];
+
+    if (TIMER_DIFF_32(now, changed_at[row][col]) < MS_TO_US(window)) {
+        return false;
+    }
+    if (pressed == !!(*cooked_row & mask)) {
+        if (deferring[row] & mask) {
+            // The switch closed again before the deferred release completed.
+            deferring[row] &= ~mask;
+            count_chatter(row, col);
+        }
+        busy[row] &= ~mask;
+        return false;
+    }
+
+    if (!pressed && window > ADAPTIVE_DEBOUNCE_BASE_MS) {
+        if (!(deferring[row] & mask)) {
+            deferring[row] |= mask;
+            busy[row] |= mask;
+            released_since[row][col] = now;
+        }
+        if (TIMER_DIFF_32(now, released_since[row][col]) < MS_TO_US(window)) {
+            return false;
+        }
+    }
+    deferring[row] &= ~mask;
+
+    if (pressed && TIMER_DIFF_32(now, changed_at[row][col]) < MS_TO_US(ADAPTIVE_DEBOUNCE_CHATTER_MS)) {
+        count_chatter(row, col);
+        if (!is_eager) {
+            window_ms[row][col] = MIN(window + ADAPTIVE_DEBOUNCE_STEP_MS, ADAPTIVE_DEBOUNCE_MAX_MS);
+        }
+    }
+    *cooked_row ^= mask;
+    changed_at[row][col] = now;
+    busy[row] |= mask;
+#if !defined(SCAN_THREAD_ENABLE)
+    // The change reaches QMK on this pass; the scan thread stamps its
+    // events when they leave the queue instead.
+    key_time_stamp(row, col, now);
+#endif
+    return true;
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool any_busy = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        any_busy |= busy[row] != 0;
+    }
+    if (!changed && !any_busy) {
+        return false;
+    }
+
+    uint32_t now            = matrix_sample_time_us();
+    bool     cooked_changed = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t candidates = (raw[row] ^ cooked[row]) | busy[row];
+        for (uint8_t col = 0; candidates; col++, candidates >>= 1) {
+            if (candidates & 1) {
+                cooked_changed |= update_key(row, col, raw[row] & (MATRIX_ROW_SHIFTER << col), &cooked[row], now);
+            }
+        }
+    }
+    return cooked_changed;
+}
+
+// Written from the main loop while the scan thread may be debouncing; a key
+// switches over on whichever scan sees the new bit, and a release it was
+// deferring completes there.
+void adaptive_debounce_set_eager(uint8_t row, uint8_t col, bool on) {
+    matrix_row_t mask = MATRIX_ROW_SHIFTER << col;
+    if (on) {
+        eager[row] |= mask;
+    } else {
+        eager[row] &= ~mask;
+    }
+}
+
+// Request:  [cmd, subsystem, op, ...]
+// INFO:     [.., .., op, rows, cols, base_ms, step_ms, max_ms, chatter_ms, raised_keys, chatter_total(4)]
+// READ:     [.., .., op, first, count, (window_ms, chatter_lo, chatter_hi) * count]
+// SET:      [.., .., op, row, col, window_ms] -> window_ms as applied
+// Keys are numbered row * cols + col.
+void adaptive_debounce_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case ADAPTIVE_DEBOUNCE_OP_INFO: {
+            uint8_t  raised = 0;
+            uint32_t total  = 0;
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    raised += window_ms[row][col] > ADAPTIVE_DEBOUNCE_BASE_MS;
+                    total += chatter[row][col];
+                }
+            }
+            payload[0] = MATRIX_ROWS;
+            payload[1] = MATRIX_COLS;
+            payload[2] = ADAPTIVE_DEBOUNCE_BASE_MS;
+            payload[3] = ADAPTIVE_DEBOUNCE_STEP_MS;
+            payload[4] = ADAPTIVE_DEBOUNCE_MAX_MS;
+            payload[5] = ADAPTIVE_DEBOUNCE_CHATTER_MS;
+            payload[6] = raised;
+            pwx_hid_write_u32(&payload[7], total);
+            break;
+        }
+        case ADAPTIVE_DEBOUNCE_OP_READ: {
+            uint8_t first = payload[0];
+            uint8_t count = (length - 5) / 3;
+            if (first >= KEY_COUNT) {
+                count = 0;
+            } else if (count > KEY_COUNT - first) {
+                count = KEY_COUNT - first;
+            }
+            payload[1] = count;
+            for (uint8_t i = 0; i < count; i++) {
+                uint8_t row = (first + i) / MATRIX_COLS;
+                uint8_t col = (first + i) % MATRIX_COLS;
+                payload[2 + i * 3] = window_ms[row][col];
+                pwx_hid_write_u16(&payload[3 + i * 3], chatter[row][col]);
+            }
+            break;
+        }
+        case ADAPTIVE_DEBOUNCE_OP_SET:
+            if (payload[0] < MATRIX_ROWS && payload[1] < MATRIX_COLS) {
+                uint8_t window                    = MAX(MIN(payload[2], ADAPTIVE_DEBOUNCE_MAX_MS), ADAPTIVE_DEBOUNCE_BASE_MS);
+                window_ms[payload[0]][payload[1]] = window;
+                payload[2]                        = window;
+            } else {
+                payload[2] = 0;
+            }
+            break;
+        case ADAPTIVE_DEBOUNCE_OP_RESET:
+            memset(window_ms, ADAPTIVE_DEBOUNCE_BASE_MS, sizeof(window_ms));
+            memset(chatter, 0, sizeof(chatter));
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Per-key debounce used as the custom DEBOUNCE_TYPE. Every key reports a
+// change on the first scan that sees it and then ignores the switch for its
+// own debounce window, so a healthy key adds no latency at all.
+//
+// A key is chattering when it is reported pressed again less than
+// ADAPTIVE_DEBOUNCE_CHATTER_MS after being reported released, which no finger
+// does. Each time that happens the window of that key alone grows by
+// ADAPTIVE_DEBOUNCE_STEP_MS, and once above the base its releases are also
+// deferred until the switch has stayed open for a whole window, which hides
+// drop-outs while the key is held. Presses stay immediate on every key.
+//
+// The learned windows live in RAM: a worn switch costs one extra keystroke
+// per boot before it is tamed again.
+//
+// Keys set eager (game mode's SOCD keys) always use the base window and
+// report releases immediately too, whatever they have learned.
+
+// Window of every key that has not chattered.
+#ifndef ADAPTIVE_DEBOUNCE_BASE_MS
+#    define ADAPTIVE_DEBOUNCE_BASE_MS DEBOUNCE
+#endif
+
+#ifndef ADAPTIVE_DEBOUNCE_CHATTER_MS
+#    define ADAPTIVE_DEBOUNCE_CHATTER_MS 15
+#endif
+
+#ifndef ADAPTIVE_DEBOUNCE_STEP_MS
+#    define ADAPTIVE_DEBOUNCE_STEP_MS 5
+#endif
+
+#ifndef ADAPTIVE_DEBOUNCE_MAX_MS
+#    define ADAPTIVE_DEBOUNCE_MAX_MS 30
+#endif
+
+typedef enum {
+    ADAPTIVE_DEBOUNCE_OP_INFO = 0x00,
+    ADAPTIVE_DEBOUNCE_OP_READ,
+    ADAPTIVE_DEBOUNCE_OP_SET,
+    ADAPTIVE_DEBOUNCE_OP_RESET,
+} adaptive_debounce_op_t;
+
+void adaptive_debounce_set_eager(uint8_t row, uint8_t col, bool on);
+void adaptive_debounce_hid_command(uint8_t *data, uint8_t length);
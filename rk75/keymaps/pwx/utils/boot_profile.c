@@ -0,0 +1,66 @@
+#include "boot_profile.h"
+
+#include "ch.h"
+#include "usb_main.h"
+#include "hid_commands.h"
+#include "key_time.h"
+#include "report_watch.h"
+
+// System ticks after which key_time_now_us() has wrapped.
+#define WRAP_TICKS (UINT32_MAX / (1000000UL / CH_CFG_ST_FREQUENCY))
+
+static uint32_t marks[BOOT_MARK_COUNT];
+static bool     complete = false;
+static bool     expired  = false; // key_time_now_us() no longer counts from boot
+
+static void check_expired(void) {
+    expired = expired || chVTGetSystemTimeX() >= WRAP_TICKS;
+}
+
+void boot_profile_mark(boot_mark_t mark) {
+    if (mark >= BOOT_MARK_COUNT || marks[mark] != 0) {
+        return;
+    }
+    check_expired();
+    uint32_t us = expired ? UINT32_MAX : key_time_now_us();
+    marks[mark] = us ? us : 1;
+}
+
+static void first_report_sent(void) {
+    boot_profile_mark(BOOT_MARK_FIRST_REPORT);
+}
+
+void boot_profile_task(void) {
+    if (complete) {
+        return;
+    }
+    check_expired();
+    if (marks[BOOT_MARK_USB_ACTIVE] == 0 && USB_DRIVER.state == USB_ACTIVE) {
+        boot_profile_mark(BOOT_MARK_USB_ACTIVE);
+    }
+    if (marks[BOOT_MARK_FIRST_REPORT] == 0) {
+        report_watch_arm(first_report_sent);
+    }
+    complete = marks[BOOT_MARK_USB_ACTIVE] != 0 && marks[BOOT_MARK_FIRST_REPORT] != 0;
+}
+
+// Request: [cmd, subsystem, op, first]
+// READ:    [.., .., op, first, mark_count, count, marks(4 each)...]
+void boot_profile_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case BOOT_PROFILE_OP_READ: {
+            uint8_t first = payload[0];
+            uint8_t count = 0;
+            for (uint8_t mark = first; mark < BOOT_MARK_COUNT && 6 + (count + 1) * 4 <= length; mark++, count++) {
+                pwx_hid_write_u32(&payload[3 + count * 4], marks[mark]);
+            }
+            payload[1] = BOOT_MARK_COUNT;
+            payload[2] = count;
+            break;
+        }
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
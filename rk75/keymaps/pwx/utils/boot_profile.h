@@ -0,0 +1,36 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Boot timeline in microseconds since the kernel started, recorded at fixed
+// points between reset and the first keyboard report and read back over raw
+// HID. A mark stays 0 until it is reached.
+//
+// Marks are key_time_now_us() values: the system tick starts from zero in
+// chSysInit() on every reset, unlike the DWT cycle counter, which keeps
+// counting across a soft reset and wraps every 44.7 s. Clock setup and HAL
+// initialization before the kernel starts are not included. A mark reached
+// after key_time_now_us() has wrapped, ~71.6 minutes in, reads UINT32_MAX.
+
+typedef enum {
+    BOOT_MARK_WEAR_LEVELING = 0, // EEPROM backing store mounted
+    BOOT_MARK_PRE_INIT,          // keyboard_pre_init_kb
+    BOOT_MARK_POST_INIT,         // keyboard_post_init_user
+    BOOT_MARK_NIGHT_CONFIG,      // night_config_load
+    BOOT_MARK_POST_INIT_DONE,    // keyboard_post_init_user returned
+    BOOT_MARK_USB_ACTIVE,        // host configured the device
+    BOOT_MARK_ENCODER_DEFAULTS,  // deferred: encoder button defaults
+    BOOT_MARK_USAGE_STATS,       // deferred: usage statistics load
+    BOOT_MARK_MACRO_STORE,       // deferred: snippet index rebuild
+    BOOT_MARK_DEFERRED_DONE,     // deferred initialization finished
+    BOOT_MARK_FIRST_REPORT,      // first keyboard, NKRO or extra-key report
+    BOOT_MARK_COUNT,
+} boot_mark_t;
+
+typedef enum {
+    BOOT_PROFILE_OP_READ = 0x00,
+} boot_profile_op_t;
+
+void boot_profile_mark(boot_mark_t mark);
+void boot_profile_task(void);
+void boot_profile_hid_command(uint8_t *data, uint8_t length);
@@ -0,0 +1,111 @@
+#include "clock_governor.h"
+
+#include <string.h>
+#include "hal.h"
+#include "hid_commands.h"
+#include "matrix_scan.h"
+
+#if CH_CFG_ST_TIMEDELTA != 0
+#    error "clock_governor: needs the periodic SysTick, which is rescaled along with the core clock"
+#endif
+
+// AHBPRE encoding used by ChibiOS's wb32_clock_init() for WB32_HPRE.
+#define AHBPRE_VALUE(divider) ((divider) == 1 ? 0x00 : (((divider) - 2) | 0x01))
+
+_Static_assert(CLOCK_GOVERNOR_IDLE_DIVIDER >= 2 && CLOCK_GOVERNOR_IDLE_DIVIDER % 2 == 0, "clock_governor: the AHB divider must be even");
+
+static bool     idle        = false;
+static uint32_t last_demand = 0;
+static uint32_t state_since = 0;
+
+static struct {
+    uint32_t full_ms;
+    uint32_t idle_ms;
+    uint32_t transitions;
+} stats;
+
+// SysTick counts core cycles, so its reload follows the clock down and back
+// up and the tick (and with it every QMK timer) keeps its period.
+static void set_divider(uint32_t divider) {
+    chSysLock();
+    RCC->AHBPRE   = AHBPRE_VALUE(divider);
+    SysTick->LOAD = WB32_HCLK / divider / CH_CFG_ST_FREQUENCY - 1;
+    SysTick->VAL  = 0;
+    chSysUnlock();
+}
+
+static void account(void) {
+    uint32_t now     = timer_read32();
+    uint32_t elapsed = TIMER_DIFF_32(now, state_since);
+    if (idle) {
+        stats.idle_ms += elapsed;
+    } else {
+        stats.full_ms += elapsed;
+    }
+    state_since = now;
+}
+
+// The trace UART's baud rate and timestamps both assume full clock.
+#if defined(EVENT_TRACE_ENABLE)
+#    define CAN_IDLE false
+#else
+#    define CAN_IDLE true
+#endif
+
+static void enter_idle(void) {
+    if (idle || !CAN_IDLE) {
+        return;
+    }
+    account();
+    set_divider(CLOCK_GOVERNOR_IDLE_DIVIDER);
+    idle = true;
+    stats.transitions++;
+}
+
+void clock_governor_demand(void) {
+    last_demand = timer_read32();
+    if (!idle) {
+        return;
+    }
+    account();
+    set_divider(1);
+    idle = false;
+    stats.transitions++;
+}
+
+uint8_t clock_governor_divider(void) {
+    return idle ? CLOCK_GOVERNOR_IDLE_DIVIDER : 1;
+}
+
+void clock_governor_suspend(void) {
+    enter_idle();
+}
+
+void clock_governor_task(void) {
+    if (idle || !matrix_is_parked() || timer_elapsed32(last_demand) < CLOCK_GOVERNOR_IDLE_MS) {
+        return;
+    }
+    enter_idle();
+}
+
+// READ: [.., .., op, idle, idle_divider, full_ms(4), idle_ms(4), transitions(4)]
+void clock_governor_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case CLOCK_GOVERNOR_OP_READ:
+            account();
+            payload[0] = idle;
+            payload[1] = CLOCK_GOVERNOR_IDLE_DIVIDER;
+            pwx_hid_write_u32(&payload[2], stats.full_ms);
+            pwx_hid_write_u32(&payload[6], stats.idle_ms);
+            pwx_hid_write_u32(&payload[10], stats.transitions);
+            break;
+        case CLOCK_GOVERNOR_OP_RESET:
+            account();
+            memset(&stats, 0, sizeof(stats));
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include <stdbool.h>
+
+// Activity-driven core clock scaling, built only with CLOCK_GOVERNOR_ENABLE.
+// The PLL and the USB prescaler are never touched: only the AHB divider
+// changes, so the 48 MHz USB clock stays valid in both states. Everything on
+// APB slows down with it, which is why the WS2812 SPI link (whose bit timing
+// depends on WS2812_SPI_DIVISOR at full speed) only ever runs at full clock:
+// a changed frame is a demand and restores full speed before it is sent.
+// The DWT cycle counter slows down too; cycle_counter.h converts its counts
+// with the divider in use.
+
+// Time without demand, with the matrix parked, before the clock drops.
+#ifndef CLOCK_GOVERNOR_IDLE_MS
+#    define CLOCK_GOVERNOR_IDLE_MS 500
+#endif
+
+// AHB divider used while idle; 4 runs the core at 24 MHz.
+#ifndef CLOCK_GOVERNOR_IDLE_DIVIDER
+#    define CLOCK_GOVERNOR_IDLE_DIVIDER 4
+#endif
+
+typedef enum {
+    CLOCK_GOVERNOR_OP_READ = 0x00,
+    CLOCK_GOVERNOR_OP_RESET,
+} clock_governor_op_t;
+
+void clock_governor_demand(void);
+
+// AHB divider in use: 1 at full clock, CLOCK_GOVERNOR_IDLE_DIVIDER while idle.
+uint8_t clock_governor_divider(void);
+void clock_governor_suspend(void);
+void clock_governor_task(void);
+void clock_governor_hid_command(uint8_t *data, uint8_t length);
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdint.h>
+
+// Packed-pixel colour kernels. A pixel is 0x00RRGGBB in one 32-bit word. The
+// kernels split it into an R_B half and a _G_ half so every channel gets a
+// 16-bit lane: one multiply then scales red and blue together, and carries
+// from one channel never reach the next. Results match the per-channel
+// integer math they replace bit for bit.
+
+typedef uint32_t rgb_pixel_t;
+
+#define RGB_PIXEL(r, g, b) (((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) | (uint32_t)(b))
+#define RGB_PIXEL_RB_MASK 0x00FF00FFu
+#define RGB_PIXEL_LANE_LOW 0x00010001u
+
+static inline uint8_t rgb_pixel_r(rgb_pixel_t px) {
+    return (px >> 16) & 0xFF;
+}
+
+static inline uint8_t rgb_pixel_g(rgb_pixel_t px) {
+    return (px >> 8) & 0xFF;
+}
+
+static inline uint8_t rgb_pixel_b(rgb_pixel_t px) {
+    return px & 0xFF;
+}
+
+// Clamps both 16-bit lanes of an R_B word to 255.
+static inline uint32_t swar_saturate_rb(uint32_t lanes) {
+    uint32_t high = (lanes >> 8) & RGB_PIXEL_RB_MASK;
+    uint32_t over = ((high + RGB_PIXEL_RB_MASK) >> 8) & RGB_PIXEL_LANE_LOW;
+    return (lanes | (over * 0xFF)) & RGB_PIXEL_RB_MASK;
+}
+
+// x / 255 in both 16-bit lanes, exact for lane values up to 255 * 255.
+static inline uint32_t swar_div255(uint32_t lanes) {
+    return ((lanes + RGB_PIXEL_LANE_LOW + ((lanes >> 8) & RGB_PIXEL_RB_MASK)) >> 8) & RGB_PIXEL_RB_MASK;
+}
+
+// min(channel * factor >> shift, 255) for every channel.
+static inline rgb_pixel_t rgb_pixel_scale_shift(rgb_pixel_t px, uint8_t factor, uint8_t shift) {
+    uint32_t rb = (((px & RGB_PIXEL_RB_MASK) * factor) >> shift) & ((0xFFFFu >> shift) * RGB_PIXEL_LANE_LOW);
+    uint32_t g  = (rgb_pixel_g(px) * (uint32_t)factor) >> shift;
+    return swar_saturate_rb(rb) | ((g > 0xFF ? 0xFF : g) << 8);
+}
+
+// min(channel * factor / divisor, 255) for divisors that are not a power of two.
+static inline rgb_pixel_t rgb_pixel_scale_div(rgb_pixel_t px, uint8_t factor, uint16_t divisor) {
+    uint32_t r = rgb_pixel_r(px) * (uint32_t)factor / divisor;
+    uint32_t g = rgb_pixel_g(px) * (uint32_t)factor / divisor;
+    uint32_t b = rgb_pixel_b(px) * (uint32_t)factor / divisor;
+    return RGB_PIXEL(r > 0xFF ? 0xFF : r, g > 0xFF ? 0xFF : g, b > 0xFF ? 0xFF : b);
+}
+
+// min(a + b, 255) for every channel.
+static inline rgb_pixel_t rgb_pixel_add_saturate(rgb_pixel_t a, rgb_pixel_t b) {
+    uint32_t rb = (a & RGB_PIXEL_RB_MASK) + (b & RGB_PIXEL_RB_MASK);
+    uint32_t g  = rgb_pixel_g(a) + rgb_pixel_g(b);
+    return swar_saturate_rb(rb) | ((g > 0xFF ? 0xFF : g) << 8);
+}
+
+// (a * (256 - t) + b * t) >> 8 for every channel; t = 256 yields b exactly.
+static inline rgb_pixel_t rgb_pixel_lerp(rgb_pixel_t a, rgb_pixel_t b, uint16_t t) {
+    uint32_t inv = 256 - t;
+    uint32_t rb  = (((a & RGB_PIXEL_RB_MASK) * inv + (b & RGB_PIXEL_RB_MASK) * t) >> 8) & RGB_PIXEL_RB_MASK;
+    uint32_t g   = ((rgb_pixel_g(a) * inv + rgb_pixel_g(b) * t) >> 8) & 0xFF;
+    return rb | (g << 8);
+}
+
+static inline void rgb_pixel_fill(rgb_pixel_t *pixels, uint8_t count, rgb_pixel_t px) {
+    for (uint8_t i = 0; i < count; i++) {
+        pixels[i] = px;
+    }
+}
+
+// HSV to RGB with 43-step hue regions, identical to the indicator's former
+// per-channel version. q and t share one multiply and one divide-by-255.
+static inline rgb_pixel_t rgb_pixel_from_hsv(uint8_t h, uint8_t s, uint8_t v) {
+    if (s == 0 || v == 0) {
+        return RGB_PIXEL(v, v, v);
+    }
+
+    uint8_t  region    = h / 43;
+    uint32_t remainder = (h - (region * 43)) * 6;
+
+    uint32_t p = (uint32_t)v * (255 - s) / 255;
+    // Low lane feeds q, high lane feeds t.
+    uint32_t lanes = swar_div255((remainder | ((255 - remainder) << 16)) * s);
+    lanes          = swar_div255(((255 * RGB_PIXEL_LANE_LOW) - lanes) * v);
+    uint32_t q     = lanes & 0xFF;
+    uint32_t t     = lanes >> 16;
+
+    switch (region) {
+        case 0:
+            return RGB_PIXEL(v, t, p);
+        case 1:
+            return RGB_PIXEL(q, v, p);
+        case 2:
+            return RGB_PIXEL(p, v, t);
+        case 3:
+            return RGB_PIXEL(p, q, v);
+        case 4:
+            return RGB_PIXEL(t, p, v);
+        default:
+            return RGB_PIXEL(v, p, q);
+    }
+}
@@ -0,0 +1,311 @@
+#include "cycle_bench.h"
+
+#include <string.h>
+#include "action_util.h"
+#include "host.h"
+#include "cycle_counter.h"
+#include "hid_commands.h"
+#include "rgb_driver.h"
+#include "rgb_matrix.h"
+#include "rgb_scheduler.h"
+#include "sentence_case.h"
+#include "socd_cleaner.h"
+#include "usage_stats.h"
+#if defined(CLOCK_GOVERNOR_ENABLE)
+#    include "clock_governor.h"
+#endif
+
+typedef enum {
+    CYCLE_BENCH_OP_INFO = 0x00,
+    CYCLE_BENCH_OP_RUN,
+    CYCLE_BENCH_OP_EFFECT,
+} cycle_bench_op_t;
+
+extern socd_cleaner_t socd_v;
+extern socd_cleaner_t socd_h;
+
+static keyrecord_t bench_record;
+static uint16_t    bench_keycode;
+static uint32_t    bench_overhead;
+
+// Presses are always followed by the matching release so every case leaves
+// the modules in the state it found them.
+static void set_event(uint8_t row, uint8_t col, uint16_t keycode, bool pressed) {
+    bench_keycode              = keycode;
+    bench_record.event.key.row = row;
+    bench_record.event.key.col = col;
+    bench_record.event.pressed = pressed;
+    bench_record.event.time    = timer_read() | 1;
+    bench_record.event.type    = KEY_EVENT;
+    bench_record.tap.count     = 0;
+}
+
+// Cases run on a scratch report: the host driver is swapped for one that
+// drops every report, and the report, mods and SOCD state are put back
+// afterwards, so nothing a case registers ever reaches the host.
+static void drop_keyboard(report_keyboard_t *report) {}
+static void drop_nkro(report_nkro_t *report) {}
+static void drop_extra(report_extra_t *report) {}
+
+static struct {
+    host_driver_t    *driver;
+    host_driver_t     scratch;
+    report_keyboard_t keyboard;
+#ifdef NKRO_ENABLE
+    report_nkro_t nkro;
+#endif
+    uint8_t        mods;
+    uint8_t        weak_mods;
+    socd_cleaner_t socd_v;
+    socd_cleaner_t socd_h;
+} saved;
+
+static void scratch_begin(void) {
+    saved.driver                = host_get_driver();
+    saved.scratch               = *saved.driver;
+    saved.scratch.send_keyboard = drop_keyboard;
+    saved.scratch.send_nkro     = drop_nkro;
+    saved.scratch.send_extra    = drop_extra;
+    host_set_driver(&saved.scratch);
+
+    saved.keyboard = *keyboard_report;
+#ifdef NKRO_ENABLE
+    saved.nkro = *nkro_report;
+#endif
+    saved.mods      = get_mods();
+    saved.weak_mods = get_weak_mods();
+    saved.socd_v    = socd_v;
+    saved.socd_h    = socd_h;
+}
+
+static void scratch_end(void) {
+    *keyboard_report = saved.keyboard;
+#ifdef NKRO_ENABLE
+    *nkro_report = saved.nkro;
+#endif
+    set_mods(saved.mods);
+    set_weak_mods(saved.weak_mods);
+    socd_v = saved.socd_v;
+    socd_h = saved.socd_h;
+    host_set_driver(saved.driver);
+}
+
+static void run_once(cycle_bench_case_t bench_case, uint16_t iteration) {
+    bool pressed = (iteration & 1) == 0;
+    switch (bench_case) {
+        case CYCLE_BENCH_RECORD_LETTER:
+            set_event(3, 1, KC_A, pressed);
+            process_record_user(bench_keycode, &bench_record);
+            break;
+        case CYCLE_BENCH_RECORD_SOCD:
+            set_event(2, 2, KC_W, pressed);
+            process_record_user(bench_keycode, &bench_record);
+            break;
+        case CYCLE_BENCH_RECORD_CUSTOM:
+            // SAFE_RANGE is SENT_CASE_TG; an even iteration count toggles it back.
+            set_event(3, 0, SAFE_RANGE, true);
+            process_record_user(bench_keycode, &bench_record);
+            break;
+        case CYCLE_BENCH_SOCD_CLEANER:
+            set_event(3, 1, KC_A, pressed);
+            process_socd_cleaner(bench_keycode, &bench_record, &socd_h);
+            break;
+        case CYCLE_BENCH_SENTENCE_CASE:
+            set_event(3, 1, KC_A, true);
+            process_sentence_case(bench_keycode, &bench_record);
+            break;
+        case CYCLE_BENCH_INDICATORS_BASE:
+        case CYCLE_BENCH_INDICATORS_FN:
+            rgb_matrix_indicators_advanced_user(0, RGB_MATRIX_LED_COUNT);
+            break;
+        case CYCLE_BENCH_INDICATORS_CHUNK:
+            rgb_matrix_indicators_advanced_user(0, RGB_MATRIX_LED_PROCESS_LIMIT);
+            break;
+        default:
+            break;
+    }
+}
+
+static uint32_t measure_overhead(void) {
+    uint32_t best = UINT32_MAX;
+    for (uint8_t i = 0; i < 16; i++) {
+        uint32_t start   = cycle_counter_read();
+        uint32_t elapsed = cycle_counter_read() - start;
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+static void add_sample(cycle_bench_result_t *result, uint32_t elapsed) {
+    if (elapsed < result->min) {
+        result->min = elapsed;
+    }
+    if (elapsed > result->max) {
+        result->max = elapsed;
+    }
+    result->total += elapsed;
+    result->iterations++;
+}
+
+// Flash wait states make cycle counts depend on the core clock, so every
+// benchmark runs at full clock.
+static void bench_begin(void) {
+#if defined(CLOCK_GOVERNOR_ENABLE)
+    clock_governor_demand();
+#endif
+    cycle_counter_init();
+    if (bench_overhead == 0) {
+        bench_overhead = measure_overhead();
+    }
+}
+
+bool cycle_bench_run(cycle_bench_case_t bench_case, cycle_bench_result_t *result) {
+    if (bench_case >= CYCLE_BENCH_CASE_COUNT || host_get_driver() == NULL) {
+        return false;
+    }
+    bench_begin();
+
+    // Benchmark presses must not show up in the statistics.
+    static usage_stats_counters_t saved_counters;
+    uint32_t                      saved_pending = usage_stats_pending;
+    memcpy(&saved_counters, &usage_stats_counters, sizeof(saved_counters));
+    layer_state_t saved_layers   = layer_state;
+    bool          sentence_saved = is_sentence_case_on();
+
+    if (bench_case == CYCLE_BENCH_INDICATORS_FN) {
+        layer_state = (layer_state_t)1 << 3;
+    }
+    if (bench_case == CYCLE_BENCH_SENTENCE_CASE) {
+        sentence_case_on();
+    }
+    scratch_begin();
+
+    result->min        = UINT32_MAX;
+    result->max        = 0;
+    result->total      = 0;
+    result->iterations = 0;
+    for (uint16_t i = 0; i < CYCLE_BENCH_ITERATIONS; i++) {
+        uint32_t start = cycle_counter_read();
+        run_once(bench_case, i);
+        uint32_t elapsed = cycle_counter_read() - start;
+        add_sample(result, elapsed > bench_overhead ? elapsed - bench_overhead : 0);
+    }
+
+    scratch_end();
+    layer_state = saved_layers;
+    if (sentence_saved) {
+        sentence_case_on();
+        sentence_case_clear();
+    } else {
+        sentence_case_off();
+    }
+    memcpy(&usage_stats_counters, &saved_counters, sizeof(saved_counters));
+    usage_stats_pending = saved_pending;
+    return true;
+}
+
+bool cycle_bench_effect(uint8_t mode, cycle_bench_result_t *result, uint16_t *chunks_per_frame) {
+    if (mode == RGB_MATRIX_NONE || mode >= RGB_MATRIX_EFFECT_MAX) {
+        return false;
+    }
+    bench_begin();
+
+    uint8_t saved_mode    = rgb_matrix_get_mode();
+    bool    saved_enabled = rgb_matrix_is_enabled();
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_mode_noeeprom(mode);
+
+    result->min        = UINT32_MAX;
+    result->max        = 0;
+    result->total      = 0;
+    result->iterations = 0;
+    *chunks_per_frame  = 0;
+
+    uint32_t frame_cycles = 0;
+    uint16_t frame_chunks = 0;
+    bool     counting     = false;
+    uint8_t  hit          = 0;
+    uint32_t started      = timer_read32();
+    while (result->iterations < CYCLE_BENCH_EFFECT_FRAMES && timer_elapsed32(started) < (CYCLE_BENCH_EFFECT_FRAMES + 2) * 100) {
+        uint32_t chunks_before = rgb_scheduler_chunk_count();
+        uint32_t frames_before = rgb_driver_frame_count();
+        uint32_t start         = cycle_counter_read();
+        rgb_matrix_task();
+        uint32_t elapsed  = cycle_counter_read() - start;
+        bool     rendered = rgb_scheduler_chunk_count() != chunks_before;
+        bool     flushed  = rgb_driver_frame_count() != frames_before;
+        // Calls that only wait for the next frame are not the effect's cost.
+        if (!rendered && !flushed) {
+            continue;
+        }
+        frame_cycles += elapsed > bench_overhead ? elapsed - bench_overhead : 0;
+        frame_chunks += rendered;
+        if (flushed) {
+            if (counting) {
+                add_sample(result, frame_cycles);
+                *chunks_per_frame = frame_chunks;
+            }
+            counting     = true;
+            frame_cycles = 0;
+            frame_chunks = 0;
+            // Letter keys on the home row, one per frame.
+            process_rgb_matrix(3, 1 + hit++ % 10, true);
+        }
+    }
+
+    rgb_matrix_mode_noeeprom(saved_mode);
+    if (!saved_enabled) {
+        rgb_matrix_disable_noeeprom();
+    }
+    if (result->iterations == 0) {
+        result->min = 0;
+    }
+    return true;
+}
+
+// INFO:   [.., .., op, case_count, iterations(2), counter_hz(4), effect_max, effect_frames]
+// RUN:    [.., .., op, case, min(4), max(4), total(4), iterations(2)]
+// EFFECT: [.., .., op, mode, min(4), max(4), total(4), frames(2), chunks_per_frame(2)]
+void cycle_bench_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case CYCLE_BENCH_OP_INFO:
+            payload[0] = CYCLE_BENCH_CASE_COUNT;
+            pwx_hid_write_u16(&payload[1], CYCLE_BENCH_ITERATIONS);
+            pwx_hid_write_u32(&payload[3], CYCLE_COUNTER_HZ);
+            payload[7] = RGB_MATRIX_EFFECT_MAX;
+            payload[8] = CYCLE_BENCH_EFFECT_FRAMES;
+            break;
+        case CYCLE_BENCH_OP_RUN: {
+            cycle_bench_result_t result;
+            if (!cycle_bench_run(payload[0], &result)) {
+                data[1] = PWX_HID_UNHANDLED;
+                break;
+            }
+            pwx_hid_write_u32(&payload[1], result.min);
+            pwx_hid_write_u32(&payload[5], result.max);
+            pwx_hid_write_u32(&payload[9], result.total);
+            pwx_hid_write_u16(&payload[13], result.iterations);
+            break;
+        }
+        case CYCLE_BENCH_OP_EFFECT: {
+            cycle_bench_result_t result;
+            uint16_t             chunks;
+            if (!cycle_bench_effect(payload[0], &result, &chunks)) {
+                data[1] = PWX_HID_UNHANDLED;
+                break;
+            }
+            pwx_hid_write_u32(&payload[1], result.min);
+            pwx_hid_write_u32(&payload[5], result.max);
+            pwx_hid_write_u32(&payload[9], result.total);
+            pwx_hid_write_u16(&payload[13], result.iterations);
+            pwx_hid_write_u16(&payload[15], chunks);
+            break;
+        }
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// On-target cycle benchmark for the keymap modules, built only with
+// CYCLE_BENCH_ENABLE = yes. Each case runs a fixed number of iterations under
+// the real LTO build and reports cycles measured with the DWT counter.
+// Nothing a case presses is sent to the host.
+//
+// Timing runs on the board rather than under QEMU: QEMU has no WB32 machine,
+// is not cycle-accurate on any Cortex-M, and -icount only counts
+// instructions. The DWT counts what the real flash wait states, Thumb-2
+// encodings and divider cost, at the price of needing a keyboard.
+//
+// Every RGB matrix effect can be timed the same way: the effect is switched
+// on without saving, and CYCLE_BENCH_EFFECT_FRAMES frames are rendered by
+// rgb_matrix_task() at their normal pace, with one key press per frame so the
+// reactive effects have hits to draw. A frame's cycles are those of the calls
+// that rendered a chunk or flushed it, indicator pass included as on the
+// keyboard. The frame that initialises the effect is not counted.
+// tools/effect_catalog.py runs it for every effect and adds flash and RAM
+// sizes from the ELF.
+
+#ifndef CYCLE_BENCH_ITERATIONS
+#    define CYCLE_BENCH_ITERATIONS 256
+#endif
+
+#ifndef CYCLE_BENCH_EFFECT_FRAMES
+#    define CYCLE_BENCH_EFFECT_FRAMES 8
+#endif
+
+typedef enum {
+    CYCLE_BENCH_RECORD_LETTER = 0,
+    CYCLE_BENCH_RECORD_SOCD,
+    CYCLE_BENCH_RECORD_CUSTOM,
+    CYCLE_BENCH_SOCD_CLEANER,
+    CYCLE_BENCH_SENTENCE_CASE,
+    CYCLE_BENCH_INDICATORS_BASE,
+    CYCLE_BENCH_INDICATORS_FN,
+    CYCLE_BENCH_INDICATORS_CHUNK,
+    CYCLE_BENCH_CASE_COUNT,
+} cycle_bench_case_t;
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint32_t total;
+    uint16_t iterations;
+} cycle_bench_result_t;
+
+bool cycle_bench_run(cycle_bench_case_t bench_case, cycle_bench_result_t *result);
+
+// Per-frame cycles of one effect; iterations is the number of frames timed,
+// short of CYCLE_BENCH_EFFECT_FRAMES only if rendering stalled.
+bool cycle_bench_effect(uint8_t mode, cycle_bench_result_t *result, uint16_t *chunks_per_frame);
+void cycle_bench_hid_command(uint8_t *data, uint8_t length);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Thin wrapper over the Cortex-M3 DWT cycle counter. ChibiOS normally has it
+// running already for its realtime counter; enabling it again is harmless and
+// it is never reset, so other users keep a monotonic count.
+//
+// It counts core cycles, which the clock governor slows down along with the
+// core. Cycle counts of CPU work stay comparable; cycle_counter_to_us()
+// converts at the clock running when it is called, so a count taken across a
+// clock change does not convert to the right time. Waits on a peripheral or
+// the host are timed with key_time_now_us() instead, which keeps its rate.
+
+#ifndef CYCLE_COUNTER_HZ
+#    define CYCLE_COUNTER_HZ 96000000UL // PLL setting in mcuconf.h
+#endif
+
+#if defined(CLOCK_GOVERNOR_ENABLE)
+#    include "clock_governor.h"
+#endif
+
+static inline void cycle_counter_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t cycle_counter_read(void) {
+    return DWT->CYCCNT;
+}
+
+static inline uint32_t cycle_counter_cycles_per_us(void) {
+#if defined(CLOCK_GOVERNOR_ENABLE)
+    return CYCLE_COUNTER_HZ / 1000000UL / clock_governor_divider();
+#else
+    return CYCLE_COUNTER_HZ / 1000000UL;
+#endif
+}
+
+static inline uint32_t cycle_counter_to_us(uint32_t cycles) {
+    return cycles / cycle_counter_cycles_per_us();
+}
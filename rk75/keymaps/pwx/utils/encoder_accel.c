@@ -0,0 +1,117 @@
+#include "encoder_accel.h"
+
+typedef struct {
+    uint16_t cw_keycode;
+    uint16_t ccw_keycode;
+    uint16_t active_keycode;
+    int16_t  burst;   // net detents of the open burst
+    int16_t  pending; // increments still to send, signed by direction
+    uint16_t interval;
+    uint16_t burst_start;
+    uint16_t last_detent;
+    uint16_t last_report;
+    bool     bursting;
+    bool     held;
+} encoder_accel_state_t;
+
+// The first detent after power-up starts a gesture like any other.
+static encoder_accel_state_t encoder_states[NUM_ENCODERS] = {[0 ... NUM_ENCODERS - 1] = {.interval = ENCODER_ACCEL_RESET_MS}};
+
+static uint8_t steps_for_interval(uint16_t interval) {
+    if (interval <= ENCODER_ACCEL_FAST_MS) {
+        return ENCODER_ACCEL_FAST_STEPS;
+    }
+    if (interval <= ENCODER_ACCEL_MEDIUM_MS) {
+        return ENCODER_ACCEL_MEDIUM_STEPS;
+    }
+    return 1;
+}
+
+bool process_encoder_accel(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_ENCODEREVENT(record->event)) {
+        return true;
+    }
+    uint8_t index = record->event.key.col;
+    if (index >= NUM_ENCODERS || keycode == KC_NO) {
+        return true;
+    }
+    if (!record->event.pressed) {
+        return false; // Releases are generated by encoder_accel_task().
+    }
+
+    encoder_accel_state_t *state     = &encoder_states[index];
+    bool                   clockwise = record->event.type == ENCODER_CW_EVENT;
+    uint16_t              *slot      = clockwise ? &state->cw_keycode : &state->ccw_keycode;
+
+    // A different keycode for the same direction means the layer changed;
+    // whatever was queued for the old binding is no longer wanted.
+    if (*slot != keycode) {
+        if (*slot != KC_NO) {
+            state->pending = 0;
+            state->burst   = 0;
+        }
+        *slot = keycode;
+    }
+
+    uint16_t elapsed = TIMER_DIFF_16(record->event.time, state->last_detent);
+    if (elapsed > ENCODER_ACCEL_RESET_MS) {
+        state->interval = ENCODER_ACCEL_RESET_MS;
+    } else {
+        state->interval = (state->interval * 3 + elapsed) / 4;
+    }
+    state->last_detent = record->event.time;
+
+    if (!state->bursting) {
+        state->bursting    = true;
+        state->burst_start = record->event.time;
+    }
+    state->burst += clockwise ? 1 : -1;
+    return false;
+}
+
+// Turns the burst into one step of increments, scaled by the spin rate.
+static void close_burst(encoder_accel_state_t *state) {
+    uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+    int16_t scale = (ENCODER_ACCEL_LAYERS & (1UL << layer)) ? steps_for_interval(state->interval) : 1;
+    int16_t step  = state->burst * scale;
+
+    state->bursting = false;
+    state->burst    = 0;
+    if (step == 0) {
+        return;
+    }
+    // The rest of a step the other way is no longer wanted.
+    int16_t pending = (step > 0) == (state->pending > 0) ? state->pending + step : step;
+    if (pending > ENCODER_ACCEL_MAX_PENDING) {
+        pending = ENCODER_ACCEL_MAX_PENDING;
+    } else if (pending < -ENCODER_ACCEL_MAX_PENDING) {
+        pending = -ENCODER_ACCEL_MAX_PENDING;
+    }
+    state->pending = pending;
+}
+
+void encoder_accel_task(void) {
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        encoder_accel_state_t *state = &encoder_states[i];
+        if (state->bursting && timer_elapsed(state->burst_start) >= ENCODER_ACCEL_BURST_MS) {
+            close_burst(state);
+        }
+        if (!state->held && state->pending == 0) {
+            continue;
+        }
+        if (timer_elapsed(state->last_report) < ENCODER_ACCEL_REPORT_MS) {
+            continue;
+        }
+        if (state->held) {
+            unregister_code16(state->active_keycode);
+            state->held = false;
+        } else {
+            bool clockwise        = state->pending > 0;
+            state->active_keycode = clockwise ? state->cw_keycode : state->ccw_keycode;
+            state->pending += clockwise ? -1 : 1;
+            register_code16(state->active_keycode);
+            state->held = true;
+        }
+        state->last_report = timer_read();
+    }
+}
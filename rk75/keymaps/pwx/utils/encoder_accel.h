@@ -0,0 +1,58 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include <stdbool.h>
+
+// Velocity-aware encoder handling. Detents from encoder_map are intercepted in
+// process_record_user() and collected into bursts. When a burst closes, its
+// net detents, scaled by the spin rate, become one step of that many volume
+// increments; the housekeeping task sends it as back-to-back taps, the only
+// form a consumer usage can take. Wobble within a burst cancels before
+// anything is sent, and turning the other way drops what is left of the
+// previous step instead of finishing it first.
+
+// Smoothed detent interval at or below which a detent counts as ENCODER_ACCEL_FAST_STEPS.
+#ifndef ENCODER_ACCEL_FAST_MS
+#    define ENCODER_ACCEL_FAST_MS 25
+#endif
+#ifndef ENCODER_ACCEL_FAST_STEPS
+#    define ENCODER_ACCEL_FAST_STEPS 4
+#endif
+
+// Smoothed detent interval at or below which a detent counts as ENCODER_ACCEL_MEDIUM_STEPS.
+#ifndef ENCODER_ACCEL_MEDIUM_MS
+#    define ENCODER_ACCEL_MEDIUM_MS 60
+#endif
+#ifndef ENCODER_ACCEL_MEDIUM_STEPS
+#    define ENCODER_ACCEL_MEDIUM_STEPS 2
+#endif
+
+// A burst collects the detents that come within this long of its first one
+// into one step, however closely they are spaced. A steady spin is thus sent
+// in slices of this length while it lasts, not only once the hand stops.
+#ifndef ENCODER_ACCEL_BURST_MS
+#    define ENCODER_ACCEL_BURST_MS 20
+#endif
+
+// A pause longer than this starts a new gesture at single-step speed.
+#ifndef ENCODER_ACCEL_RESET_MS
+#    define ENCODER_ACCEL_RESET_MS 200
+#endif
+
+// Minimum time between two report changes; a tap is two changes.
+#ifndef ENCODER_ACCEL_REPORT_MS
+#    define ENCODER_ACCEL_REPORT_MS 5
+#endif
+
+// Increments that may be queued per encoder; detents beyond this are dropped.
+#ifndef ENCODER_ACCEL_MAX_PENDING
+#    define ENCODER_ACCEL_MAX_PENDING 24
+#endif
+
+// Layers on which acceleration applies. Other layers still coalesce, one step per detent.
+#ifndef ENCODER_ACCEL_LAYERS
+#    define ENCODER_ACCEL_LAYERS 0xFFFFFFFFu
+#endif
+
+bool process_encoder_accel(uint16_t keycode, keyrecord_t *record);
+void encoder_accel_task(void);
@@ -0,0 +1,115 @@
+#include "encoder_quadrature.h"
+
+#include "encoder.h"
+#include "hid_commands.h"
+
+#ifndef ENCODER_RESOLUTION
+#    define ENCODER_RESOLUTION 4
+#endif
+
+#ifndef ENCODER_CLOCKWISE
+#    ifdef ENCODER_DIRECTION_FLIP
+#        define ENCODER_CLOCKWISE false
+#        define ENCODER_COUNTER_CLOCKWISE true
+#    else
+#        define ENCODER_CLOCKWISE true
+#        define ENCODER_COUNTER_CLOCKWISE false
+#    endif
+#endif
+
+#define ENCODER_TRANSITION_INVALID 2
+
+// Indexed by (previous AB << 2) | current AB. Both pins changing at once means
+// an edge was missed; it moves nothing and is counted instead.
+static const int8_t transition_table[16] = {
+    0,  -1, 1,  ENCODER_TRANSITION_INVALID,
+    1,  0,  ENCODER_TRANSITION_INVALID, -1,
+    -1, ENCODER_TRANSITION_INVALID, 0,  1,
+    ENCODER_TRANSITION_INVALID, 1,  -1, 0,
+};
+
+static const pin_t encoder_pins_a[] = ENCODER_A_PINS;
+static const pin_t encoder_pins_b[] = ENCODER_B_PINS;
+
+typedef struct {
+    // Written only by the edge interrupt.
+    volatile int32_t  pulses;
+    volatile uint32_t invalid;
+    volatile uint32_t edges;
+    uint8_t           state;
+    // Owned by the main loop.
+    int32_t consumed;
+} encoder_quadrature_t;
+
+static encoder_quadrature_t encoders[NUM_ENCODERS];
+
+static uint8_t read_pins(uint8_t index) {
+    return (gpio_read_pin(encoder_pins_a[index]) << 0) | (gpio_read_pin(encoder_pins_b[index]) << 1);
+}
+
+static void encoder_edge_callback(void *arg) {
+    uint8_t               index   = (uint8_t)(uintptr_t)arg;
+    encoder_quadrature_t *encoder = &encoders[index];
+
+    encoder->state = ((encoder->state << 2) | read_pins(index)) & 0x0F;
+    int8_t delta   = transition_table[encoder->state];
+    if (delta == ENCODER_TRANSITION_INVALID) {
+        encoder->invalid++;
+    } else {
+        encoder->pulses += delta;
+    }
+    encoder->edges++;
+}
+
+void encoder_driver_init(void) {
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        gpio_set_pin_input_high(encoder_pins_a[i]);
+        gpio_set_pin_input_high(encoder_pins_b[i]);
+    }
+    // Let the pull-ups settle before sampling the starting position.
+    wait_us(100);
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        encoders[i].state = read_pins(i);
+        palSetLineCallback(encoder_pins_a[i], encoder_edge_callback, (void *)(uintptr_t)i);
+        palSetLineCallback(encoder_pins_b[i], encoder_edge_callback, (void *)(uintptr_t)i);
+        palEnableLineEvent(encoder_pins_a[i], PAL_EVENT_MODE_BOTH_EDGES);
+        palEnableLineEvent(encoder_pins_b[i], PAL_EVENT_MODE_BOTH_EDGES);
+    }
+}
+
+void encoder_driver_task(void) {
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        encoder_quadrature_t *encoder = &encoders[i];
+        // A single aligned 32-bit load; the interrupt is the only writer.
+        int32_t pending = encoder->pulses - encoder->consumed;
+
+        // Pulses stay in the counter until the event queue has room for them.
+        while (pending >= ENCODER_RESOLUTION && !encoder_queue_full()) {
+            encoder_queue_event(i, ENCODER_COUNTER_CLOCKWISE);
+            encoder->consumed += ENCODER_RESOLUTION;
+            pending -= ENCODER_RESOLUTION;
+        }
+        while (pending <= -ENCODER_RESOLUTION && !encoder_queue_full()) {
+            encoder_queue_event(i, ENCODER_CLOCKWISE);
+            encoder->consumed -= ENCODER_RESOLUTION;
+            pending += ENCODER_RESOLUTION;
+        }
+    }
+}
+
+// Counters only ever grow; the host diffs successive reads.
+// Request:  [cmd, subsystem, op, index]
+// COUNTERS: [.., .., op, index, pulses(4), consumed(4), edges(4), invalid(4)]
+void encoder_quadrature_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    uint8_t  index   = payload[0];
+    if (data[2] != ENCODER_QUADRATURE_OP_COUNTERS || index >= NUM_ENCODERS) {
+        data[1] = PWX_HID_UNHANDLED;
+        return;
+    }
+    encoder_quadrature_t *encoder = &encoders[index];
+    pwx_hid_write_u32(&payload[1], (uint32_t)encoder->pulses);
+    pwx_hid_write_u32(&payload[5], (uint32_t)encoder->consumed);
+    pwx_hid_write_u32(&payload[9], encoder->edges);
+    pwx_hid_write_u32(&payload[13], encoder->invalid);
+}
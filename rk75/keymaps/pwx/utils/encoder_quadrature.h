@@ -0,0 +1,14 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Interrupt-driven quadrature decoding for the rotary encoders, used as the
+// custom ENCODER_DRIVER. Edges on either pin update a per-encoder pulse count
+// from the PAL callback; encoder_driver_task() turns whole detents into
+// encoder events from the main loop without ever losing pulses.
+
+typedef enum {
+    ENCODER_QUADRATURE_OP_COUNTERS = 0x00,
+} encoder_quadrature_op_t;
+
+void encoder_quadrature_hid_command(uint8_t *data, uint8_t length);
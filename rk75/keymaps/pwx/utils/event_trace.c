@@ -0,0 +1,81 @@
+#include "event_trace.h"
+
+#include "hal.h"
+#include "cycle_counter.h"
+#include "report_watch.h"
+#include "timer_wheel.h"
+
+#if !HAL_USE_SERIAL || !WB32_SERIAL_USE_UART3
+#    error "event_trace: needs HAL_USE_SERIAL and WB32_SERIAL_USE_UART3"
+#endif
+
+// 8N1; the field encodings are those of QMK's serial_usart driver for WB32.
+static const SerialConfig trace_serial_config = {
+    .speed  = EVENT_TRACE_BAUD,
+    .wrdlen = 3,
+    .stpbit = 0,
+    .parity = 0,
+    .atflct = 0,
+};
+
+static bool     started = false;
+static uint16_t dropped = 0;
+static MUTEX_DECL(trace_lock);
+
+static void put_record(uint8_t type, uint16_t arg, uint32_t cycles) {
+    uint8_t record[EVENT_TRACE_RECORD_SIZE] = {
+        EVENT_TRACE_SYNC, type, arg & 0xFF, arg >> 8, cycles & 0xFF, (cycles >> 8) & 0xFF, (cycles >> 16) & 0xFF, cycles >> 24,
+    };
+    sdAsynchronousWrite(&SD3, record, sizeof(record));
+}
+
+static void report_sent(void) {
+    event_trace(EVENT_TRACE_REPORT, 0);
+    // The watch is one-shot; the original driver is back in place by now.
+    report_watch_arm(report_sent);
+}
+
+static uint32_t heartbeat(void *arg) {
+    event_trace(EVENT_TRACE_HEARTBEAT, timer_read32() / 1000);
+    return EVENT_TRACE_HEARTBEAT_MS;
+}
+
+void event_trace_init(void) {
+    cycle_counter_init();
+    palSetLineMode(EVENT_TRACE_TX_PIN, PAL_MODE_ALTERNATE(EVENT_TRACE_TX_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL | PAL_OUTPUT_SPEED_HIGHEST);
+    sdStart(&SD3, &trace_serial_config);
+    started = true;
+    report_watch_arm(report_sent);
+    timer_wheel_schedule(EVENT_TRACE_HEARTBEAT_MS, heartbeat, NULL);
+}
+
+// Writers hold the mutex (the scan thread traces too) and only the UART
+// interrupt drains the queue, so free space checked here can only grow before
+// the write; a record is either queued whole or not at all and the stream
+// never carries a torn record.
+void event_trace(event_trace_type_t type, uint16_t arg) {
+    if (!started) {
+        return;
+    }
+    uint32_t cycles = cycle_counter_read();
+
+    chMtxLock(&trace_lock);
+    size_t needed = dropped ? 2 * EVENT_TRACE_RECORD_SIZE : EVENT_TRACE_RECORD_SIZE;
+
+    chSysLock();
+    size_t space = oqGetEmptyI(&SD3.oqueue);
+    chSysUnlock();
+
+    if (space < needed) {
+        if (dropped < UINT16_MAX) {
+            dropped++;
+        }
+    } else {
+        if (dropped) {
+            put_record(EVENT_TRACE_OVERFLOW, dropped, cycles);
+            dropped = 0;
+        }
+        put_record(type, arg, cycles);
+    }
+    chMtxUnlock(&trace_lock);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Binary event trace on UART3, built only with EVENT_TRACE_ENABLE. Every
+// event is one 8-byte record:
+//
+//   [0xA5, type, arg (2, LE), cycles (4, LE)]
+//
+// where cycles is the DWT cycle counter when the event was traced. Records go
+// straight into the serial driver's output queue and the UART interrupt
+// drains it, so tracing never waits on the line. When the queue is full the
+// record is dropped and counted; the next record that fits is preceded by an
+// EVENT_TRACE_OVERFLOW carrying the count. tools/trace_decode.py turns a
+// capture into a timeline.
+//
+// The cycle counter wraps every 44.7 s, so a gap longer than that between two
+// records cannot be told from a short one. A heartbeat record every
+// EVENT_TRACE_HEARTBEAT_MS, also while the host sleeps, keeps gaps shorter,
+// and the seconds since boot it carries let the decoder re-anchor its
+// timeline after records were lost.
+//
+// Without EVENT_TRACE_ENABLE event_trace() compiles to nothing, so trace
+// points stay in place in every build.
+
+// UART3 TX. B10, the usual pin, is a matrix column on this board.
+#ifndef EVENT_TRACE_TX_PIN
+#    define EVENT_TRACE_TX_PIN C10
+#endif
+
+#ifndef EVENT_TRACE_TX_PAL_MODE
+#    define EVENT_TRACE_TX_PAL_MODE 7
+#endif
+
+// 96 MHz / 16 / 3; a rate the UART divides exactly and common USB serial
+// adapters accept.
+#ifndef EVENT_TRACE_BAUD
+#    define EVENT_TRACE_BAUD 2000000
+#endif
+
+#ifndef EVENT_TRACE_HEARTBEAT_MS
+#    define EVENT_TRACE_HEARTBEAT_MS 10000
+#endif
+
+_Static_assert(EVENT_TRACE_HEARTBEAT_MS < 40000, "event_trace: heartbeats must come more often than the cycle counter wraps");
+
+#define EVENT_TRACE_SYNC 0xA5
+#define EVENT_TRACE_RECORD_SIZE 8
+
+typedef enum {
+    EVENT_TRACE_MATRIX_EDGE = 0x01, // raw matrix change: EVENT_TRACE_KEY_ARG
+    EVENT_TRACE_KEY_EVENT,          // debounced event reaching process_record: EVENT_TRACE_KEY_ARG
+    EVENT_TRACE_SOCD,               // SOCD decision: EVENT_TRACE_SOCD_* | keycode
+    EVENT_TRACE_REPORT,             // report handed to the host driver
+    EVENT_TRACE_FRAME,              // RGB frame flushed: 1 if sent to the LEDs, 0 if unchanged
+    EVENT_TRACE_FLASH,              // flash write: source << 8 | EVENT_TRACE_FLASH_*
+    EVENT_TRACE_KEY_AGE,            // after KEY_EVENT: us since its scan sampled it, saturating
+    EVENT_TRACE_HEARTBEAT,          // every EVENT_TRACE_HEARTBEAT_MS: seconds since boot, wrapping
+    EVENT_TRACE_OVERFLOW = 0x7F,    // records dropped since the last one sent
+} event_trace_type_t;
+
+#define EVENT_TRACE_KEY_ARG(row, col, pressed) ((uint16_t)((pressed) ? 0x8000 : 0) | ((uint16_t)(row) << 8) | (col))
+
+#define EVENT_TRACE_SOCD_PRESS 0x8000   // cleaner pressed the opposing key
+#define EVENT_TRACE_SOCD_RELEASE 0x0000 // cleaner released the opposing key
+#define EVENT_TRACE_SOCD_SWALLOW 0x4000 // current key suppressed
+
+typedef enum {
+    EVENT_TRACE_FLASH_PROGRAM = 0,
+    EVENT_TRACE_FLASH_ERASE,
+} event_trace_flash_op_t;
+
+typedef enum {
+    EVENT_TRACE_SOURCE_WEAR_LEVELING = 0,
+    EVENT_TRACE_SOURCE_USAGE_STATS,
+    EVENT_TRACE_SOURCE_MACRO_STORE,
+} event_trace_source_t;
+
+#define EVENT_TRACE_FLASH_ARG(source, op) ((uint16_t)((source) << 8) | (op))
+
+#if defined(EVENT_TRACE_ENABLE)
+void event_trace_init(void);
+void event_trace(event_trace_type_t type, uint16_t arg);
+#else
+static inline void event_trace_init(void) {}
+static inline void event_trace(event_trace_type_t type, uint16_t arg) {
+    (void)type;
+    (void)arg;
+}
+#endif
@@ -0,0 +1,94 @@
+#include "fast_resume.h"
+
+#include <string.h>
+#include "rgb_driver.h"
+#include "hid_commands.h"
+#include "key_time.h"
+#include "report_watch.h"
+
+static rgb_pixel_t snapshot[RGB_MATRIX_LED_COUNT];
+static bool        suspended         = false;
+static bool        restoring         = false;
+static bool        waiting_for_frame = false;
+static uint32_t    wakeup_us;
+static uint32_t    wakeup_frame_count;
+
+static struct {
+    uint32_t suspends;
+    uint32_t resumes;
+    uint32_t restore_us; // wakeup to the saved frame being back on the LEDs
+    uint32_t frame_us;   // wakeup to the first frame rendered by the RGB matrix
+    uint32_t report_us;  // wakeup to the first report sent to the host
+} stats;
+
+static uint32_t since_wakeup_us(void) {
+    // The clock governor switches back to full clock during the wakeup.
+    return TIMER_DIFF_32(key_time_now_us(), wakeup_us);
+}
+
+// Runs on every pass of the suspend loop. Only the first pass still sees the
+// frame that was shown, before the RGB matrix blanks the LEDs for sleep. The
+// snapshot is what the driver last sent, not the frame being rendered, which
+// a chunked render may have left half done.
+void fast_resume_suspend(void) {
+    if (suspended) {
+        return;
+    }
+    suspended = true;
+    stats.suspends++;
+    memcpy(snapshot, rgb_driver_shown(), sizeof(snapshot));
+}
+
+static void first_report_sent(void) {
+    stats.report_us = since_wakeup_us();
+}
+
+void fast_resume_wakeup(void) {
+    if (!suspended) {
+        return;
+    }
+    suspended     = false;
+    wakeup_us     = key_time_now_us();
+    stats.resumes++;
+    stats.frame_us  = 0;
+    stats.report_us = 0;
+
+    // Held back by the driver until the LED supply has settled, so the first
+    // scans and reports go ahead meanwhile. Game mode or a light stream put
+    // their own frame back instead.
+    rgb_driver_restore(snapshot);
+    stats.restore_us = 0;
+    restoring        = true;
+
+    wakeup_frame_count = rgb_driver_frame_count();
+    waiting_for_frame  = true;
+    report_watch_arm(first_report_sent);
+}
+
+void fast_resume_task(void) {
+    if (restoring && rgb_driver_idle()) {
+        restoring        = false;
+        stats.restore_us = since_wakeup_us();
+    }
+    if (waiting_for_frame && rgb_driver_frame_count() != wakeup_frame_count) {
+        waiting_for_frame = false;
+        stats.frame_us    = since_wakeup_us();
+    }
+}
+
+// READ: [.., .., op, suspends(4), resumes(4), restore_us(4), frame_us(4), report_us(4)]
+void fast_resume_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case FAST_RESUME_OP_READ:
+            pwx_hid_write_u32(&payload[0], stats.suspends);
+            pwx_hid_write_u32(&payload[4], stats.resumes);
+            pwx_hid_write_u32(&payload[8], stats.restore_us);
+            pwx_hid_write_u32(&payload[12], stats.frame_us);
+            pwx_hid_write_u32(&payload[16], stats.report_us);
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Keeps the last frame shown before USB suspend and puts it back on the LEDs
+// in a single flush as soon as the host resumes, instead of leaving them dark
+// until the RGB matrix has rendered a new frame. Layer and indicator state
+// stay in RAM across suspend, so the frame is all that needs saving.
+
+typedef enum {
+    FAST_RESUME_OP_READ = 0x00,
+} fast_resume_op_t;
+
+void fast_resume_suspend(void);
+void fast_resume_wakeup(void);
+void fast_resume_task(void);
+void fast_resume_hid_command(uint8_t *data, uint8_t length);
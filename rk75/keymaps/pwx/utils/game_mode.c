@@ -0,0 +1,166 @@
+#include "game_mode.h"
+
+#include <string.h>
+#include "adaptive_debounce.h"
+#include "hid_commands.h"
+#include "indicators.h"
+#include "key_time.h"
+#include "rgb_driver.h"
+#include "rgb_matrix.h"
+
+static rgb_pixel_t    frame[RGB_MATRIX_LED_COUNT];
+static bool           active          = false;
+static bool           rgb_was_enabled = false;
+static debug_config_t saved_debug;
+static matrix_row_t   eager[MATRIX_ROWS];
+static uint32_t       last_pass       = 0; // key_time_now_us()
+static bool           last_pass_valid = false;
+
+typedef struct {
+    uint32_t passes;
+    uint64_t pass_us;
+    uint32_t pass_max_us;
+    uint32_t events;
+    uint64_t age_us; // scan sample to the keymap
+    uint32_t age_max_us;
+} mode_stats_t;
+
+static mode_stats_t stats[2];
+
+static mode_stats_t *current_stats(void) {
+    return &stats[active ? GAME_MODE_STATS_GAME : GAME_MODE_STATS_NORMAL];
+}
+
+// Keys are looked up on the default layer, so the same keys are eager
+// whether the mode was toggled from the Fn layers or restored at boot.
+static void set_eager_keys(const uint16_t *keys, uint8_t count) {
+    uint8_t layer = get_highest_layer(default_layer_state);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t key     = {.row = row, .col = col};
+            uint16_t keycode = keymap_key_to_keycode(layer, key);
+            for (uint8_t i = 0; i < count; i++) {
+                if (keycode == keys[i]) {
+                    eager[row] |= MATRIX_ROW_SHIFTER << col;
+                    adaptive_debounce_set_eager(row, col, true);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void clear_eager_keys(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; eager[row]; col++) {
+            if (eager[row] & (MATRIX_ROW_SHIFTER << col)) {
+                eager[row] &= ~(MATRIX_ROW_SHIFTER << col);
+                adaptive_debounce_set_eager(row, col, false);
+            }
+        }
+    }
+}
+
+// A live lighting stream keeps the LEDs until it ends; the driver shows
+// this frame then.
+static void show_frame(void) {
+    rgb_driver_write_external(RGB_DRIVER_EXTERNAL_GAME_MODE, frame);
+}
+
+void game_mode_enter(const uint16_t *eager_keys, uint8_t count) {
+    if (active) {
+        return;
+    }
+    active          = true;
+    last_pass_valid = false;
+    set_eager_keys(eager_keys, count);
+
+    saved_debug      = debug_config;
+    debug_config.raw = 0;
+
+    // Built once; nothing in it changes while the mode is on.
+    rgb_was_enabled = rgb_matrix_is_enabled();
+    rgb_matrix_disable_noeeprom();
+    indicators_render_game_mode(frame);
+    show_frame();
+}
+
+void game_mode_exit(void) {
+    if (!active) {
+        return;
+    }
+    active          = false;
+    last_pass_valid = false;
+    clear_eager_keys();
+    debug_config = saved_debug;
+    rgb_driver_release_external(RGB_DRIVER_EXTERNAL_GAME_MODE);
+    if (rgb_was_enabled) {
+        rgb_matrix_enable_noeeprom();
+    }
+}
+
+bool game_mode_active(void) {
+    return active;
+}
+
+void game_mode_wakeup(void) {
+    if (active) {
+        show_frame();
+    }
+}
+
+void game_mode_record(keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event)) {
+        return;
+    }
+    mode_stats_t *mode = current_stats();
+    uint32_t      age  = TIMER_DIFF_32(key_time_now_us(), key_time_of(record));
+    mode->events++;
+    mode->age_us += age;
+    mode->age_max_us = MAX(mode->age_max_us, age);
+}
+
+void game_mode_task(void) {
+    uint32_t now = key_time_now_us();
+    if (last_pass_valid) {
+        mode_stats_t *mode = current_stats();
+        uint32_t      pass = TIMER_DIFF_32(now, last_pass);
+        mode->passes++;
+        mode->pass_us += pass;
+        mode->pass_max_us = MAX(mode->pass_max_us, pass);
+    }
+    last_pass       = now;
+    last_pass_valid = true;
+}
+
+static uint32_t mean(uint64_t total, uint32_t count) {
+    return count ? (uint32_t)(total / count) : 0;
+}
+
+// Request:  [cmd, subsystem, op, ...]
+// READ:     [.., .., op, mode] -> [.., .., op, mode, active, passes(4), pass_mean_us(4), pass_max_us(4),
+//                                  events(4), age_mean_us(4), age_max_us(4)]
+// RESET:    both modes
+void game_mode_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case GAME_MODE_OP_READ: {
+            const mode_stats_t *mode = &stats[payload[0] == GAME_MODE_STATS_GAME ? GAME_MODE_STATS_GAME : GAME_MODE_STATS_NORMAL];
+            payload[1]               = active;
+            pwx_hid_write_u32(&payload[2], mode->passes);
+            pwx_hid_write_u32(&payload[6], mean(mode->pass_us, mode->passes));
+            pwx_hid_write_u32(&payload[10], mode->pass_max_us);
+            pwx_hid_write_u32(&payload[14], mode->events);
+            pwx_hid_write_u32(&payload[18], mean(mode->age_us, mode->events));
+            pwx_hid_write_u32(&payload[22], mode->age_max_us);
+            break;
+        }
+        case GAME_MODE_OP_RESET:
+            memset(stats, 0, sizeof(stats));
+            last_pass_valid = false;
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
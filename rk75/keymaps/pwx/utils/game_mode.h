@@ -0,0 +1,48 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Minimal input pipeline for games. While it is on:
+//
+//   - key events go through the SOCD cleaners and the keymap's own keycodes
+//     only; sentence case, usage statistics, knob acceleration, reactive
+//     lighting and snippet interruption are skipped
+//   - the RGB matrix is switched off without touching its saved settings,
+//     and the LEDs show one static frame built by the indicators (the SOCD
+//     keys lit, or nothing at all with GAME_MODE_LIGHTS_OFF), so no effect
+//     is rendered between scans
+//   - QMK's debug flags are cleared, so console output costs nothing
+//   - the SOCD keys debounce eagerly both ways (adaptive_debounce.h): their
+//     learned windows and deferred releases are ignored
+//
+// The keymap turns NKRO on and keeps the setting across reboots. The time
+// between main loop passes and the age of key events when they reach the
+// keymap are measured separately for both modes, so the difference can be
+// read back over raw HID.
+
+typedef enum {
+    GAME_MODE_OP_READ = 0x00,
+    GAME_MODE_OP_RESET,
+} game_mode_op_t;
+
+typedef enum {
+    GAME_MODE_STATS_NORMAL = 0,
+    GAME_MODE_STATS_GAME,
+} game_mode_stats_t;
+
+// `eager_keys` are keycodes; every key that currently produces one of them
+// gets eager debounce.
+void game_mode_enter(const uint16_t *eager_keys, uint8_t count);
+void game_mode_exit(void);
+bool game_mode_active(void);
+
+// Puts the static frame back on the LEDs after USB suspend.
+void game_mode_wakeup(void);
+
+// Every key event, in both modes, before anything else looks at it.
+void game_mode_record(keyrecord_t *record);
+
+// Once per main loop pass.
+void game_mode_task(void);
+
+void game_mode_hid_command(uint8_t *data, uint8_t length);
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+
+// Raw HID requests handled by this keymap arrive through via_command_kb().
+// Byte 0 is PWX_HID_COMMAND_ID, byte 1 selects the subsystem and the rest of
+// the report belongs to that subsystem. Replies reuse the same buffer.
+#define PWX_HID_COMMAND_ID 0xA0
+
+typedef enum {
+    PWX_HID_USAGE_STATS    = 0x01,
+    PWX_HID_ENCODER        = 0x02,
+    PWX_HID_CYCLE_BENCH    = 0x03,
+    PWX_HID_MACRO_STORE    = 0x04,
+    PWX_HID_WEAR_LEVELING  = 0x05,
+    PWX_HID_BOOT_PROFILE   = 0x06,
+    PWX_HID_RESUME         = 0x07,
+    PWX_HID_CLOCK_GOVERNOR = 0x08,
+    PWX_HID_DEBOUNCE       = 0x09,
+    PWX_HID_SCAN_THREAD    = 0x0A,
+    PWX_HID_LED_POWER      = 0x0B,
+    PWX_HID_LIGHT_STREAM   = 0x0C,
+    PWX_HID_RGB_SCHEDULER  = 0x0D,
+    PWX_HID_GAME_MODE      = 0x0E,
+    PWX_HID_TIMER_WHEEL    = 0x0F,
+} pwx_hid_subsystem_t;
+
+// Written to byte 1 when no subsystem claims the request.
+#define PWX_HID_UNHANDLED 0xFF
+
+static inline uint16_t pwx_hid_read_u16(const uint8_t *data) {
+    return (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+}
+
+static inline void pwx_hid_write_u16(uint8_t *data, uint16_t value) {
+    data[0] = value & 0xFF;
+    data[1] = value >> 8;
+}
+
+static inline void pwx_hid_write_u32(uint8_t *data, uint32_t value) {
+    data[0] = value & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = (value >> 16) & 0xFF;
+    data[3] = value >> 24;
+}
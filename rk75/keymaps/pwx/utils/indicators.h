@@ -2,6 +2,7 @@
 
 #include QMK_KEYBOARD_H
 #include <stdbool.h>
+#include "color_swar.h"
 
 typedef enum {
     SOCD_MODE_LAST = 0,
@@ -18,3 +19,7 @@ void indicators_trigger_eeprom_feedback(void);
 void indicators_set_night_hsv(HSV hsv);
 void indicators_set_night_enabled(bool enabled);
 bool indicators_is_night_enabled(void);
+
+// The static frame shown in game mode: the SOCD keys in the game mode colour
+// on black, or all black with GAME_MODE_LIGHTS_OFF.
+void indicators_render_game_mode(rgb_pixel_t *frame);
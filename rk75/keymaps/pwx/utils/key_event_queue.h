@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Single-producer, single-consumer ring of debounced key events. Each side
+// only ever writes its own index, and the release store of that index is
+// what hands a slot over, so neither side takes a lock or masks interrupts.
+// Indices run freely and wrap at 256; one full lap is never outstanding
+// because the size is at most 128.
+
+#ifndef KEY_EVENT_QUEUE_SIZE
+#    define KEY_EVENT_QUEUE_SIZE 32
+#endif
+
+_Static_assert(KEY_EVENT_QUEUE_SIZE > 0 && KEY_EVENT_QUEUE_SIZE <= 128 && (KEY_EVENT_QUEUE_SIZE & (KEY_EVENT_QUEUE_SIZE - 1)) == 0, "key_event_queue: size must be a power of two up to 128");
+
+typedef struct {
+    uint32_t time; // key_time_now_us() when the scan that saw it sampled the rows
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+} key_event_t;
+
+typedef struct {
+    key_event_t slots[KEY_EVENT_QUEUE_SIZE];
+    uint8_t     head; // next slot to fill; written by the producer only
+    uint8_t     tail; // next slot to take; written by the consumer only
+} key_event_queue_t;
+
+// Producer side.
+static inline uint8_t key_event_queue_count(const key_event_queue_t *queue) {
+    return (uint8_t)(queue->head - __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE));
+}
+
+// Producer side; false when the queue is full and nothing was written.
+static inline bool key_event_queue_push(key_event_queue_t *queue, const key_event_t *event) {
+    uint8_t head = queue->head;
+    if ((uint8_t)(head - __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE)) == KEY_EVENT_QUEUE_SIZE) {
+        return false;
+    }
+    queue->slots[head % KEY_EVENT_QUEUE_SIZE] = *event;
+    __atomic_store_n(&queue->head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+    return true;
+}
+
+// Consumer side; the oldest event, or NULL when the queue is empty. The slot
+// stays valid until key_event_queue_pop().
+static inline const key_event_t *key_event_queue_peek(const key_event_queue_t *queue) {
+    uint8_t tail = queue->tail;
+    if (__atomic_load_n(&queue->head, __ATOMIC_ACQUIRE) == tail) {
+        return NULL;
+    }
+    return &queue->slots[tail % KEY_EVENT_QUEUE_SIZE];
+}
+
+// Consumer side; only after a successful peek.
+static inline void key_event_queue_pop(key_event_queue_t *queue) {
+    __atomic_store_n(&queue->tail, (uint8_t)(queue->tail + 1), __ATOMIC_RELEASE);
+}
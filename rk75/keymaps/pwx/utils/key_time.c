@@ -0,0 +1,42 @@
+#include "key_time.h"
+
+#include "hal.h"
+
+#if CH_CFG_ST_TIMEDELTA != 0 || CH_CFG_ST_RESOLUTION != 32
+#    error "key_time: needs the periodic 32-bit SysTick time base"
+#endif
+
+#define US_PER_TICK (1000000UL / CH_CFG_ST_FREQUENCY)
+
+_Static_assert(1000000UL % CH_CFG_ST_FREQUENCY == 0, "key_time: the system tick must be a whole number of microseconds");
+
+static uint32_t stamps[MATRIX_ROWS][MATRIX_COLS];
+
+// Ticks times US_PER_TICK wraps modulo 2^32 along with the tick count, so the
+// result wraps cleanly too. A SysTick that has reloaded but whose interrupt
+// has not run yet (pending while the lock is held) belongs to the next tick.
+uint32_t key_time_now_us(void) {
+    syssts_t sts   = chSysGetStatusAndLockX();
+    uint32_t ticks = chVTGetSystemTimeX();
+    uint32_t load  = SysTick->LOAD;
+    uint32_t value = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        ticks++;
+        value = SysTick->VAL;
+    }
+    chSysRestoreStatusX(sts);
+    return ticks * US_PER_TICK + (load - value) * US_PER_TICK / (load + 1);
+}
+
+void key_time_stamp(uint8_t row, uint8_t col, uint32_t sampled_us) {
+    stamps[row][col] = sampled_us;
+}
+
+uint32_t key_time_of(const keyrecord_t *record) {
+    uint8_t row = record->event.key.row;
+    uint8_t col = record->event.key.col;
+    if (record->event.type != KEY_EVENT || row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+        return key_time_now_us();
+    }
+    return stamps[row][col];
+}
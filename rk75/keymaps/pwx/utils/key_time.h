@@ -0,0 +1,23 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Microsecond timestamps for key events. QMK's keyevent_t only carries a
+// 16-bit millisecond time taken when the event is processed; this keeps a
+// 32-bit microsecond time per key, taken when the matrix scan that saw the
+// change sampled the rows, so code handling an event can tell when it really
+// happened and in what order events from different scans occurred.
+//
+// The clock is the system tick count refined with the SysTick down-counter.
+// It keeps its rate when the clock governor rescales the core clock, is
+// safe to read from any thread or interrupt and wraps every ~71.6 minutes:
+// compare times with TIMER_DIFF_32().
+
+uint32_t key_time_now_us(void);
+
+// Records when the change of a key that is about to reach QMK was sampled.
+void key_time_stamp(uint8_t row, uint8_t col, uint32_t sampled_us);
+
+// When the change behind a record was sampled. Events that do not come from
+// the matrix (encoders, combos, injected records) get the current time.
+uint32_t key_time_of(const keyrecord_t *record);
@@ -0,0 +1,665 @@
+// Generated by tools/gen_led_layout.py from keyboard.json. Do not edit.
+#include "led_layout.h"
+
+const uint8_t matrix_to_led[LED_LAYOUT_ROWS][LED_LAYOUT_COLS] = {
+    { 21,  20,  19,  18,  17,  16,  15,  14,  13,  12,  11,  10,   9,   8, 255},
+    { 22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,   7},
+    { 49,  48,  47,  46,  45,  44,  43,  42,  41,  40,  39,  38,  37,  36,   6},
+    { 50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255,  62,   5},
+    { 75,  74,  73,  72,  71,  70,  69,  68,  67,  66,  65,  64, 255,  63, 255},
+    { 76,  77,  78, 255, 255,  79, 255, 255, 255,   0,   1, 255,   2,   3,   4},
+};
+
+const uint8_t led_to_matrix[LED_LAYOUT_COUNT] = {
+     89,  90,  92,  93,  94,  62,  46,  30,  13,  12,  11,  10,   9,   8,   7,   6,
+      5,   4,   3,   2,   1,   0,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,
+     26,  27,  28,  29,  45,  44,  43,  42,  41,  40,  39,  38,  37,  36,  35,  34,
+     33,  32,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  61,  77,
+     75,  74,  73,  72,  71,  70,  69,  68,  67,  66,  65,  64,  80,  81,  82,  85,
+};
+
+const uint8_t led_neighbors[LED_LAYOUT_COUNT][LED_NEIGHBOR_COUNT] = {
+    { 79,   1,  66, 255},
+    {  0,   2,  65, 255},
+    {  1,   3,  37, 255},
+    {  2,   4,  63, 255},
+    {  3, 255,   5, 255},
+    { 62, 255,   6,   4},
+    { 36, 255,   7,   5},
+    { 35, 255, 255,   6},
+    {  9,   7, 255,  35},
+    { 10,   8, 255,  34},
+    { 11,   9, 255,  33},
+    { 12,  10, 255,  32},
+    { 13,  11, 255,  31},
+    { 14,  12, 255,  30},
+    { 15,  13, 255,  29},
+    { 16,  14, 255,  28},
+    { 17,  15, 255,  27},
+    { 18,  16, 255,  26},
+    { 19,  17, 255,  25},
+    { 20,  18, 255,  24},
+    { 21,  19, 255,  23},
+    {255,  20, 255,  22},
+    {255,  23,  21,  49},
+    { 22,  24,  20,  48},
+    { 23,  25,  19,  47},
+    { 24,  26,  18,  46},
+    { 25,  27,  17,  45},
+    { 26,  28,  16,  44},
+    { 27,  29,  15,  43},
+    { 28,  30,  14,  42},
+    { 29,  31,  13,  41},
+    { 30,  32,  12,  40},
+    { 31,  33,  11,  39},
+    { 32,  34,  10,  38},
+    { 33,  35,   9,  37},
+    { 34,   7,   8,  36},
+    { 37,   6,  35,  62},
+    { 38,  36,  34,   2},
+    { 39,  37,  33,  61},
+    { 40,  38,  32,  60},
+    { 41,  39,  31,  59},
+    { 42,  40,  30,  58},
+    { 43,  41,  29,  57},
+    { 44,  42,  28,  56},
+    { 45,  43,  27,  55},
+    { 46,  44,  26,  54},
+    { 47,  45,  25,  53},
+    { 48,  46,  24,  52},
+    { 49,  47,  23,  51},
+    {255,  48,  22,  50},
+    {255,  51,  49,  75},
+    { 50,  52,  48,  74},
+    { 51,  53,  47,  73},
+    { 52,  54,  46,  72},
+    { 53,  55,  45,  71},
+    { 54,  56,  44,  70},
+    { 55,  57,  43,  69},
+    { 56,  58,  42,  68},
+    { 57,  59,  41,  67},
+    { 58,  60,  40,  66},
+    { 59,  61,  39,  65},
+    { 60,  62,  38,  64},
+    { 61,   5,  36,  63},
+    { 64,   4,  62,   3},
+    { 65,  63,  61, 255},
+    { 66,  64,  60,   1},
+    { 67,  65,  59,   0},
+    { 68,  66,  58, 255},
+    { 69,  67,  57, 255},
+    { 70,  68,  56, 255},
+    { 71,  69,  55,  79},
+    { 72,  70,  54, 255},
+    { 73,  71,  53, 255},
+    { 74,  72,  52,  78},
+    { 75,  73,  51,  77},
+    {255,  74,  50,  76},
+    {255,  77,  75, 255},
+    { 76,  78,  74, 255},
+    { 77,  79,  73, 255},
+    { 78,   0,  70, 255},
+};
+
+const uint8_t led_distance[LED_LAYOUT_COUNT][LED_LAYOUT_COUNT] = {
+    {
+          0,  16,  48,  64,  80,  84,  88,  94,  90,  80,  71,  65,  64,  65,  71,  80,
+         90, 102, 115, 128, 143, 157, 152, 137, 123, 108,  94,  81,  70,  60,  53,  51,
+         53,  60,  70,  81,  74,  61,  49,  41,  38,  41,  49,  61,  74,  88, 103, 118,
+        133, 148, 146, 130, 114,  99,  84,  69,  54,  41,  30,  26,  30,  41,  69,  65,
+         34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 144, 128, 112,  64,
+    },
+    {
+         16,   0,  32,  48,  64,  69,  74,  81,  80,  71,  65,  64,  65,  71,  80,  90,
+        102, 115, 128, 143, 157, 172, 167, 152, 137, 123, 108,  94,  81,  70,  60,  53,
+         51,  53,  60,  70,  61,  49,  41,  38,  41,  49,  61,  74,  88, 103, 118, 133,
+        148, 164, 162, 146, 130, 114,  99,  84,  69,  54,  41,  30,  26,  30,  54,  49,
+         20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 160, 160, 144, 128,  80,
+    },
+    {
+         48,  32,   0,  16,  32,  41,  49,  60,  65,  64,  65,  71,  80,  90, 102, 115,
+        128, 143, 157, 172, 187, 202, 198, 183, 167, 152, 137, 123, 108,  94,  81,  70,
+         60,  53,  51,  53,  41,  38,  41,  49,  61,  74,  88, 103, 118, 133, 148, 164,
+        180, 195, 193, 177, 162, 146, 130, 114,  99,  84,  69,  54,  41,  30,  30,  20,
+         20,  34,  49,  65,  81,  96, 112, 128, 144, 160, 176, 192, 192, 176, 160, 112,
+    },
+    {
+         64,  48,  16,   0,  16,  30,  41,  53,  64,  65,  71,  80,  90, 102, 115, 128,
+        143, 157, 172, 187, 202, 217, 214, 198, 183, 167, 152, 137, 123, 108,  94,  81,
+         70,  60,  53,  51,  38,  41,  49,  61,  74,  88, 103, 118, 133, 148, 164, 180,
+        195, 211, 209, 193, 177, 162, 146, 130, 114,  99,  84,  69,  54,  41,  26,  13,
+         34,  49,  65,  81,  96, 112, 128, 144, 160, 176, 192, 208, 208, 192, 176, 128,
+    },
+    {
+         80,  64,  32,  16,   0,  26,  38,  51,  65,  71,  80,  90, 102, 115, 128, 143,
+        157, 172, 187, 202, 217, 232, 229, 214, 198, 183, 167, 152, 137, 123, 108,  94,
+         81,  70,  60,  53,  41,  49,  61,  74,  88, 103, 118, 133, 148, 164, 180, 195,
+        211, 227, 225, 209, 193, 177, 162, 146, 130, 114,  99,  84,  69,  54,  30,  20,
+         49,  65,  81,  96, 112, 128, 144, 160, 176, 192, 208, 224, 224, 208, 192, 144,
+    },
+    {
+         84,  69,  41,  30,  26,   0,  12,  25,  41,  49,  61,  74,  88, 103, 118, 133,
+        148, 164, 180, 195, 211, 227, 225, 209, 193, 177, 161, 146, 130, 114,  99,  83,
+         68,  54,  40,  29,  20,  34,  49,  65,  80,  96, 112, 128, 144, 160, 176, 192,
+        208, 224, 224, 208, 192, 176, 160, 144, 128, 112,  96,  80,  64,  48,  16,  20,
+         49,  65,  81,  96, 112, 128, 144, 160, 176, 192, 208, 224, 225, 209, 193, 146,
+    },
+    {
+         88,  74,  49,  41,  38,  12,   0,  13,  30,  41,  54,  69,  84,  99, 114, 130,
+        146, 162, 177, 193, 209, 225, 224, 208, 192, 176, 160, 144, 128, 112,  96,  81,
+         65,  49,  34,  20,  16,  32,  48,  64,  80,  96, 112, 128, 144, 160, 176, 192,
+        208, 224, 224, 208, 192, 176, 160, 144, 128, 112,  96,  80,  65,  49,  20,  29,
+         54,  68,  83,  99, 114, 130, 146, 161, 177, 193, 209, 225, 227, 211, 195, 148,
+    },
+    {
+         94,  81,  60,  53,  51,  25,  13,   0,  20,  34,  49,  65,  81,  96, 112, 128,
+        144, 160, 176, 192, 208, 224, 224, 208, 192, 176, 160, 144, 128, 112,  96,  80,
+         64,  48,  32,  16,  20,  34,  49,  65,  81,  96, 112, 128, 144, 160, 176, 192,
+        208, 224, 225, 209, 193, 177, 161, 146, 130, 114,  99,  83,  68,  54,  29,  41,
+         61,  74,  88, 103, 118, 133, 148, 164, 180, 195, 211, 227, 229, 214, 198, 152,
+    },
+    {
+         90,  80,  65,  64,  65,  41,  30,  20,   0,  16,  32,  48,  64,  80,  96, 112,
+        128, 144, 160, 176, 192, 208, 208, 192, 176, 160, 144, 128, 112,  96,  81,  65,
+         49,  34,  20,  13,  26,  30,  41,  54,  69,  84,  99, 114, 130, 146, 162, 177,
+        193, 209, 211, 195, 180, 164, 148, 133, 118, 103,  88,  74,  61,  49,  38,  51,
+         60,  70,  81,  94, 108, 123, 137, 152, 167, 183, 198, 214, 217, 202, 187, 143,
+    },
+    {
+         80,  71,  64,  65,  71,  49,  41,  34,  16,   0,  16,  32,  48,  64,  80,  96,
+        112, 128, 144, 160, 176, 192, 192, 176, 160, 144, 128, 112,  96,  81,  65,  49,
+         34,  20,  13,  20,  30,  26,  30,  41,  54,  69,  84,  99, 114, 130, 146, 162,
+        177, 193, 195, 180, 164, 148, 133, 118, 103,  88,  74,  61,  49,  41,  41,  53,
+         53,  60,  70,  81,  94, 108, 123, 137, 152, 167, 183, 198, 202, 187, 172, 128,
+    },
+    {
+         71,  65,  65,  71,  80,  61,  54,  49,  32,  16,   0,  16,  32,  48,  64,  80,
+         96, 112, 128, 144, 160, 176, 176, 160, 144, 128, 112,  96,  81,  65,  49,  34,
+         20,  13,  20,  34,  41,  30,  26,  30,  41,  54,  69,  84,  99, 114, 130, 146,
+        162, 177, 180, 164, 148, 133, 118, 103,  88,  74,  61,  49,  41,  38,  49,  60,
+         51,  53,  60,  70,  81,  94, 108, 123, 137, 152, 167, 183, 187, 172, 157, 115,
+    },
+    {
+         65,  64,  71,  80,  90,  74,  69,  65,  48,  32,  16,   0,  16,  32,  48,  64,
+         80,  96, 112, 128, 144, 160, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,
+         13,  20,  34,  49,  54,  41,  30,  26,  30,  41,  54,  69,  84,  99, 114, 130,
+        146, 162, 164, 148, 133, 118, 103,  88,  74,  61,  49,  41,  38,  41,  61,  70,
+         53,  51,  53,  60,  70,  81,  94, 108, 123, 137, 152, 167, 172, 157, 143, 102,
+    },
+    {
+         64,  65,  80,  90, 102,  88,  84,  81,  64,  48,  32,  16,   0,  16,  32,  48,
+         64,  80,  96, 112, 128, 144, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,
+         20,  34,  49,  65,  69,  54,  41,  30,  26,  30,  41,  54,  69,  84,  99, 114,
+        130, 146, 148, 133, 118, 103,  88,  74,  61,  49,  41,  38,  41,  49,  74,  81,
+         60,  53,  51,  53,  60,  70,  81,  94, 108, 123, 137, 152, 157, 143, 128,  90,
+    },
+    {
+         65,  71,  90, 102, 115, 103,  99,  96,  80,  64,  48,  32,  16,   0,  16,  32,
+         48,  64,  80,  96, 112, 128, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,
+         34,  49,  65,  81,  84,  69,  54,  41,  30,  26,  30,  41,  54,  69,  84,  99,
+        114, 130, 133, 118, 103,  88,  74,  61,  49,  41,  38,  41,  49,  61,  88,  94,
+         70,  60,  53,  51,  53,  60,  70,  81,  94, 108, 123, 137, 143, 128, 115,  80,
+    },
+    {
+         71,  80, 102, 115, 128, 118, 114, 112,  96,  80,  64,  48,  32,  16,   0,  16,
+         32,  48,  64,  80,  96, 112, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,
+         49,  65,  81,  96,  99,  84,  69,  54,  41,  30,  26,  30,  41,  54,  69,  84,
+         99, 114, 118, 103,  88,  74,  61,  49,  41,  38,  41,  49,  61,  74, 103, 108,
+         81,  70,  60,  53,  51,  53,  60,  70,  81,  94, 108, 123, 128, 115, 102,  71,
+    },
+    {
+         80,  90, 115, 128, 143, 133, 130, 128, 112,  96,  80,  64,  48,  32,  16,   0,
+         16,  32,  48,  64,  80,  96,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,
+         65,  81,  96, 112, 114,  99,  84,  69,  54,  41,  30,  26,  30,  41,  54,  69,
+         84,  99, 103,  88,  74,  61,  49,  41,  38,  41,  49,  61,  74,  88, 118, 123,
+         94,  81,  70,  60,  53,  51,  53,  60,  70,  81,  94, 108, 115, 102,  90,  65,
+    },
+    {
+         90, 102, 128, 143, 157, 148, 146, 144, 128, 112,  96,  80,  64,  48,  32,  16,
+          0,  16,  32,  48,  64,  80,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,
+         81,  96, 112, 128, 130, 114,  99,  84,  69,  54,  41,  30,  26,  30,  41,  54,
+         69,  84,  88,  74,  61,  49,  41,  38,  41,  49,  61,  74,  88, 103, 133, 137,
+        108,  94,  81,  70,  60,  53,  51,  53,  60,  70,  81,  94, 102,  90,  80,  64,
+    },
+    {
+        102, 115, 143, 157, 172, 164, 162, 160, 144, 128, 112,  96,  80,  64,  48,  32,
+         16,   0,  16,  32,  48,  64,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,
+         96, 112, 128, 144, 146, 130, 114,  99,  84,  69,  54,  41,  30,  26,  30,  41,
+         54,  69,  74,  61,  49,  41,  38,  41,  49,  61,  74,  88, 103, 118, 148, 152,
+        123, 108,  94,  81,  70,  60,  53,  51,  53,  60,  70,  81,  90,  80,  71,  65,
+    },
+    {
+        115, 128, 157, 172, 187, 180, 177, 176, 160, 144, 128, 112,  96,  80,  64,  48,
+         32,  16,   0,  16,  32,  48,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96,
+        112, 128, 144, 160, 162, 146, 130, 114,  99,  84,  69,  54,  41,  30,  26,  30,
+         41,  54,  61,  49,  41,  38,  41,  49,  61,  74,  88, 103, 118, 133, 164, 167,
+        137, 123, 108,  94,  81,  70,  60,  53,  51,  53,  60,  70,  80,  71,  65,  71,
+    },
+    {
+        128, 143, 172, 187, 202, 195, 193, 192, 176, 160, 144, 128, 112,  96,  80,  64,
+         48,  32,  16,   0,  16,  32,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112,
+        128, 144, 160, 176, 177, 162, 146, 130, 114,  99,  84,  69,  54,  41,  30,  26,
+         30,  41,  49,  41,  38,  41,  49,  61,  74,  88, 103, 118, 133, 148, 180, 183,
+        152, 137, 123, 108,  94,  81,  70,  60,  53,  51,  53,  60,  71,  65,  64,  80,
+    },
+    {
+        143, 157, 187, 202, 217, 211, 209, 208, 192, 176, 160, 144, 128, 112,  96,  80,
+         64,  48,  32,  16,   0,  16,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128,
+        144, 160, 176, 192, 193, 177, 162, 146, 130, 114,  99,  84,  69,  54,  41,  30,
+         26,  30,  41,  38,  41,  49,  61,  74,  88, 103, 118, 133, 148, 164, 195, 198,
+        167, 152, 137, 123, 108,  94,  81,  70,  60,  53,  51,  53,  65,  64,  65,  90,
+    },
+    {
+        157, 172, 202, 217, 232, 227, 225, 224, 208, 192, 176, 160, 144, 128, 112,  96,
+         80,  64,  48,  32,  16,   0,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144,
+        160, 176, 192, 208, 209, 193, 177, 162, 146, 130, 114,  99,  84,  69,  54,  41,
+         30,  26,  38,  41,  49,  61,  74,  88, 103, 118, 133, 148, 164, 180, 211, 214,
+        183, 167, 152, 137, 123, 108,  94,  81,  70,  60,  53,  51,  64,  65,  71, 102,
+    },
+    {
+        152, 167, 198, 214, 229, 225, 224, 224, 208, 192, 176, 160, 144, 128, 112,  96,
+         81,  65,  49,  34,  20,  13,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144,
+        160, 176, 192, 208, 208, 192, 176, 160, 144, 128, 112,  96,  81,  65,  49,  34,
+         20,  13,  25,  29,  40,  54,  68,  83,  99, 114, 130, 146, 161, 177, 209, 211,
+        180, 164, 148, 133, 118, 103,  88,  74,  61,  49,  41,  38,  51,  53,  60,  94,
+    },
+    {
+        137, 152, 183, 198, 214, 209, 208, 208, 192, 176, 160, 144, 128, 112,  96,  81,
+         65,  49,  34,  20,  13,  20,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128,
+        144, 160, 176, 192, 192, 176, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,
+         13,  20,  29,  25,  29,  40,  54,  68,  83,  99, 114, 130, 146, 161, 193, 195,
+        164, 148, 133, 118, 103,  88,  74,  61,  49,  41,  38,  41,  53,  51,  53,  81,
+    },
+    {
+        123, 137, 167, 183, 198, 193, 192, 192, 176, 160, 144, 128, 112,  96,  81,  65,
+         49,  34,  20,  13,  20,  34,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112,
+        128, 144, 160, 176, 176, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,
+         20,  34,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114, 130, 146, 177, 180,
+        148, 133, 118, 103,  88,  74,  61,  49,  41,  38,  41,  49,  60,  53,  51,  70,
+    },
+    {
+        108, 123, 152, 167, 183, 177, 176, 176, 160, 144, 128, 112,  96,  81,  65,  49,
+         34,  20,  13,  20,  34,  49,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96,
+        112, 128, 144, 160, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,
+         34,  49,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114, 130, 161, 164,
+        133, 118, 103,  88,  74,  61,  49,  41,  38,  41,  49,  61,  70,  60,  53,  60,
+    },
+    {
+         94, 108, 137, 152, 167, 161, 160, 160, 144, 128, 112,  96,  81,  65,  49,  34,
+         20,  13,  20,  34,  49,  65,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80,
+         96, 112, 128, 144, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,
+         49,  65,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114, 146, 148,
+        118, 103,  88,  74,  61,  49,  41,  38,  41,  49,  61,  74,  81,  70,  60,  53,
+    },
+    {
+         81,  94, 123, 137, 152, 146, 144, 144, 128, 112,  96,  81,  65,  49,  34,  20,
+         13,  20,  34,  49,  65,  81,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,
+         80,  96, 112, 128, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,
+         65,  81,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99, 130, 133,
+        103,  88,  74,  61,  49,  41,  38,  41,  49,  61,  74,  88,  94,  81,  70,  51,
+    },
+    {
+         70,  81, 108, 123, 137, 130, 128, 128, 112,  96,  81,  65,  49,  34,  20,  13,
+         20,  34,  49,  65,  81,  96,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,
+         64,  80,  96, 112, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,
+         81,  96,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83, 114, 118,
+         88,  74,  61,  49,  41,  38,  41,  49,  61,  74,  88, 103, 108,  94,  81,  53,
+    },
+    {
+         60,  70,  94, 108, 123, 114, 112, 112,  96,  81,  65,  49,  34,  20,  13,  20,
+         34,  49,  65,  81,  96, 112, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,
+         48,  64,  80,  96,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,
+         96, 112, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,  99, 103,
+         74,  61,  49,  41,  38,  41,  49,  61,  74,  88, 103, 118, 123, 108,  94,  60,
+    },
+    {
+         53,  60,  81,  94, 108,  99,  96,  96,  81,  65,  49,  34,  20,  13,  20,  34,
+         49,  65,  81,  96, 112, 128, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,
+         32,  48,  64,  80,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96,
+        112, 128, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,  83,  88,
+         61,  49,  41,  38,  41,  49,  61,  74,  88, 103, 118, 133, 137, 123, 108,  70,
+    },
+    {
+         51,  53,  70,  81,  94,  83,  81,  80,  65,  49,  34,  20,  13,  20,  34,  49,
+         65,  81,  96, 112, 128, 144, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,
+         16,  32,  48,  64,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112,
+        128, 144, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,  68,  74,
+         49,  41,  38,  41,  49,  61,  74,  88, 103, 118, 133, 148, 152, 137, 123,  81,
+    },
+    {
+         53,  51,  60,  70,  81,  68,  65,  64,  49,  34,  20,  13,  20,  34,  49,  65,
+         81,  96, 112, 128, 144, 160, 160, 144, 128, 112,  96,  80,  64,  48,  32,  16,
+          0,  16,  32,  48,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128,
+        144, 160, 161, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,  54,  61,
+         41,  38,  41,  49,  61,  74,  88, 103, 118, 133, 148, 164, 167, 152, 137,  94,
+    },
+    {
+         60,  53,  53,  60,  70,  54,  49,  48,  34,  20,  13,  20,  34,  49,  65,  81,
+         96, 112, 128, 144, 160, 176, 176, 160, 144, 128, 112,  96,  80,  64,  48,  32,
+         16,   0,  16,  32,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144,
+        160, 176, 177, 161, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,  40,  49,
+         38,  41,  49,  61,  74,  88, 103, 118, 133, 148, 164, 180, 183, 167, 152, 108,
+    },
+    {
+         70,  60,  51,  53,  60,  40,  34,  32,  20,  13,  20,  34,  49,  65,  81,  96,
+        112, 128, 144, 160, 176, 192, 192, 176, 160, 144, 128, 112,  96,  80,  64,  48,
+         32,  16,   0,  16,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 160,
+        176, 192, 193, 177, 161, 146, 130, 114,  99,  83,  68,  54,  40,  29,  29,  41,
+         41,  49,  61,  74,  88, 103, 118, 133, 148, 164, 180, 195, 198, 183, 167, 123,
+    },
+    {
+         81,  70,  53,  51,  53,  29,  20,  16,  13,  20,  34,  49,  65,  81,  96, 112,
+        128, 144, 160, 176, 192, 208, 208, 192, 176, 160, 144, 128, 112,  96,  80,  64,
+         48,  32,  16,   0,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 160, 176,
+        192, 208, 209, 193, 177, 161, 146, 130, 114,  99,  83,  68,  54,  40,  25,  38,
+         49,  61,  74,  88, 103, 118, 133, 148, 164, 180, 195, 211, 214, 198, 183, 137,
+    },
+    {
+         74,  61,  41,  38,  41,  20,  16,  20,  26,  30,  41,  54,  69,  84,  99, 114,
+        130, 146, 162, 177, 193, 209, 208, 192, 176, 160, 144, 128, 112,  96,  81,  65,
+         49,  34,  20,  13,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144, 160, 176,
+        192, 208, 208, 192, 176, 160, 144, 128, 112,  96,  80,  65,  49,  34,  12,  25,
+         40,  54,  68,  83,  99, 114, 130, 146, 161, 177, 193, 209, 211, 195, 180, 133,
+    },
+    {
+         61,  49,  38,  41,  49,  34,  32,  34,  30,  26,  30,  41,  54,  69,  84,  99,
+        114, 130, 146, 162, 177, 193, 192, 176, 160, 144, 128, 112,  96,  81,  65,  49,
+         34,  20,  13,  20,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144, 160,
+        176, 192, 192, 176, 160, 144, 128, 112,  96,  80,  65,  49,  34,  20,  20,  29,
+         29,  40,  54,  68,  83,  99, 114, 130, 146, 161, 177, 193, 195, 180, 164, 118,
+    },
+    {
+         49,  41,  41,  49,  61,  49,  48,  49,  41,  30,  26,  30,  41,  54,  69,  84,
+         99, 114, 130, 146, 162, 177, 176, 160, 144, 128, 112,  96,  81,  65,  49,  34,
+         20,  13,  20,  34,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144,
+        160, 176, 176, 160, 144, 128, 112,  96,  80,  65,  49,  34,  20,  12,  34,  40,
+         25,  29,  40,  54,  68,  83,  99, 114, 130, 146, 161, 177, 180, 164, 148, 103,
+    },
+    {
+         41,  38,  49,  61,  74,  65,  64,  65,  54,  41,  30,  26,  30,  41,  54,  69,
+         84,  99, 114, 130, 146, 162, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,
+         13,  20,  34,  49,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128,
+        144, 160, 160, 144, 128, 112,  96,  80,  65,  49,  34,  20,  12,  20,  49,  54,
+         29,  25,  29,  40,  54,  68,  83,  99, 114, 130, 146, 161, 164, 148, 133,  88,
+    },
+    {
+         38,  41,  61,  74,  88,  80,  80,  81,  69,  54,  41,  30,  26,  30,  41,  54,
+         69,  84,  99, 114, 130, 146, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,
+         20,  34,  49,  65,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112,
+        128, 144, 144, 128, 112,  96,  80,  65,  49,  34,  20,  12,  20,  34,  65,  68,
+         40,  29,  25,  29,  40,  54,  68,  83,  99, 114, 130, 146, 148, 133, 118,  74,
+    },
+    {
+         41,  49,  74,  88, 103,  96,  96,  96,  84,  69,  54,  41,  30,  26,  30,  41,
+         54,  69,  84,  99, 114, 130, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,
+         34,  49,  65,  81,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96,
+        112, 128, 128, 112,  96,  80,  65,  49,  34,  20,  12,  20,  34,  49,  80,  83,
+         54,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114, 130, 133, 118, 103,  61,
+    },
+    {
+         49,  61,  88, 103, 118, 112, 112, 112,  99,  84,  69,  54,  41,  30,  26,  30,
+         41,  54,  69,  84,  99, 114, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,
+         49,  65,  81,  96,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80,
+         96, 112, 112,  96,  80,  65,  49,  34,  20,  12,  20,  34,  49,  65,  96,  99,
+         68,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114, 118, 103,  88,  49,
+    },
+    {
+         61,  74, 103, 118, 133, 128, 128, 128, 114,  99,  84,  69,  54,  41,  30,  26,
+         30,  41,  54,  69,  84,  99,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,
+         65,  81,  96, 112, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,
+         80,  96,  96,  80,  65,  49,  34,  20,  12,  20,  34,  49,  65,  80, 112, 114,
+         83,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99, 103,  88,  74,  41,
+    },
+    {
+         74,  88, 118, 133, 148, 144, 144, 144, 130, 114,  99,  84,  69,  54,  41,  30,
+         26,  30,  41,  54,  69,  84,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,
+         81,  96, 112, 128, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,
+         64,  80,  80,  65,  49,  34,  20,  12,  20,  34,  49,  65,  80,  96, 128, 130,
+         99,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83,  88,  74,  61,  38,
+    },
+    {
+         88, 103, 133, 148, 164, 160, 160, 160, 146, 130, 114,  99,  84,  69,  54,  41,
+         30,  26,  30,  41,  54,  69,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,
+         96, 112, 128, 144, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,
+         48,  64,  65,  49,  34,  20,  12,  20,  34,  49,  65,  80,  96, 112, 144, 146,
+        114,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,  74,  61,  49,  41,
+    },
+    {
+        103, 118, 148, 164, 180, 176, 176, 176, 162, 146, 130, 114,  99,  84,  69,  54,
+         41,  30,  26,  30,  41,  54,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96,
+        112, 128, 144, 160, 160, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,
+         32,  48,  49,  34,  20,  12,  20,  34,  49,  65,  80,  96, 112, 128, 160, 161,
+        130, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,  61,  49,  41,  49,
+    },
+    {
+        118, 133, 164, 180, 195, 192, 192, 192, 177, 162, 146, 130, 114,  99,  84,  69,
+         54,  41,  30,  26,  30,  41,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112,
+        128, 144, 160, 176, 176, 160, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,
+         16,  32,  34,  20,  12,  20,  34,  49,  65,  80,  96, 112, 128, 144, 176, 177,
+        146, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,  49,  41,  38,  61,
+    },
+    {
+        133, 148, 180, 195, 211, 208, 208, 208, 193, 177, 162, 146, 130, 114,  99,  84,
+         69,  54,  41,  30,  26,  30,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128,
+        144, 160, 176, 192, 192, 176, 160, 144, 128, 112,  96,  80,  64,  48,  32,  16,
+          0,  16,  20,  12,  20,  34,  49,  65,  80,  96, 112, 128, 144, 160, 192, 193,
+        161, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,  41,  38,  41,  74,
+    },
+    {
+        148, 164, 195, 211, 227, 224, 224, 224, 209, 193, 177, 162, 146, 130, 114,  99,
+         84,  69,  54,  41,  30,  26,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144,
+        160, 176, 192, 208, 208, 192, 176, 160, 144, 128, 112,  96,  80,  64,  48,  32,
+         16,   0,  12,  20,  34,  49,  65,  80,  96, 112, 128, 144, 160, 176, 208, 209,
+        177, 161, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,  38,  41,  49,  88,
+    },
+    {
+        146, 162, 193, 209, 225, 224, 224, 225, 211, 195, 180, 164, 148, 133, 118, 103,
+         88,  74,  61,  49,  41,  38,  25,  29,  40,  54,  68,  83,  99, 114, 130, 146,
+        161, 177, 193, 209, 208, 192, 176, 160, 144, 128, 112,  96,  80,  65,  49,  34,
+         20,  12,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144, 160, 176, 208, 208,
+        176, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  26,  30,  41,  84,
+    },
+    {
+        130, 146, 177, 193, 209, 208, 208, 209, 195, 180, 164, 148, 133, 118, 103,  88,
+         74,  61,  49,  41,  38,  41,  29,  25,  29,  40,  54,  68,  83,  99, 114, 130,
+        146, 161, 177, 193, 192, 176, 160, 144, 128, 112,  96,  80,  65,  49,  34,  20,
+         12,  20,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144, 160, 192, 192,
+        160, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  30,  26,  30,  69,
+    },
+    {
+        114, 130, 162, 177, 193, 192, 192, 193, 180, 164, 148, 133, 118, 103,  88,  74,
+         61,  49,  41,  38,  41,  49,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114,
+        130, 146, 161, 177, 176, 160, 144, 128, 112,  96,  80,  65,  49,  34,  20,  12,
+         20,  34,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144, 176, 176,
+        144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  41,  30,  26,  54,
+    },
+    {
+         99, 114, 146, 162, 177, 176, 176, 177, 164, 148, 133, 118, 103,  88,  74,  61,
+         49,  41,  38,  41,  49,  61,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99,
+        114, 130, 146, 161, 160, 144, 128, 112,  96,  80,  65,  49,  34,  20,  12,  20,
+         34,  49,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128, 160, 160,
+        128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  54,  41,  30,  41,
+    },
+    {
+         84,  99, 130, 146, 162, 160, 160, 161, 148, 133, 118, 103,  88,  74,  61,  49,
+         41,  38,  41,  49,  61,  74,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83,
+         99, 114, 130, 146, 144, 128, 112,  96,  80,  65,  49,  34,  20,  12,  20,  34,
+         49,  65,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112, 144, 144,
+        112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  69,  54,  41,  30,
+    },
+    {
+         69,  84, 114, 130, 146, 144, 144, 146, 133, 118, 103,  88,  74,  61,  49,  41,
+         38,  41,  49,  61,  74,  88,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,
+         83,  99, 114, 130, 128, 112,  96,  80,  65,  49,  34,  20,  12,  20,  34,  49,
+         65,  80,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96, 128, 128,
+         96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,  84,  69,  54,  26,
+    },
+    {
+         54,  69,  99, 114, 130, 128, 128, 130, 118, 103,  88,  74,  61,  49,  41,  38,
+         41,  49,  61,  74,  88, 103,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,
+         68,  83,  99, 114, 112,  96,  80,  65,  49,  34,  20,  12,  20,  34,  49,  65,
+         80,  96,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80, 112, 112,
+         81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96,  99,  84,  69,  30,
+    },
+    {
+         41,  54,  84,  99, 114, 112, 112, 114, 103,  88,  74,  61,  49,  41,  38,  41,
+         49,  61,  74,  88, 103, 118, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,
+         54,  68,  83,  99,  96,  80,  65,  49,  34,  20,  12,  20,  34,  49,  65,  80,
+         96, 112, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,  96,  96,
+         65,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 114,  99,  84,  41,
+    },
+    {
+         30,  41,  69,  84,  99,  96,  96,  99,  88,  74,  61,  49,  41,  38,  41,  49,
+         61,  74,  88, 103, 118, 133, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,
+         40,  54,  68,  83,  80,  65,  49,  34,  20,  12,  20,  34,  49,  65,  80,  96,
+        112, 128, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,  80,  81,
+         49,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 130, 114,  99,  54,
+    },
+    {
+         26,  30,  54,  69,  84,  80,  80,  83,  74,  61,  49,  41,  38,  41,  49,  61,
+         74,  88, 103, 118, 133, 148, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,
+         29,  40,  54,  68,  65,  49,  34,  20,  12,  20,  34,  49,  65,  80,  96, 112,
+        128, 144, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,  64,  65,
+         34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 146, 130, 114,  69,
+    },
+    {
+         30,  26,  41,  54,  69,  64,  65,  68,  61,  49,  41,  38,  41,  49,  61,  74,
+         88, 103, 118, 133, 148, 164, 161, 146, 130, 114,  99,  83,  68,  54,  40,  29,
+         25,  29,  40,  54,  49,  34,  20,  12,  20,  34,  49,  65,  80,  96, 112, 128,
+        144, 160, 160, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,  48,  49,
+         20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 160, 162, 146, 130,  84,
+    },
+    {
+         41,  30,  30,  41,  54,  48,  49,  54,  49,  41,  38,  41,  49,  61,  74,  88,
+        103, 118, 133, 148, 164, 180, 177, 161, 146, 130, 114,  99,  83,  68,  54,  40,
+         29,  25,  29,  40,  34,  20,  12,  20,  34,  49,  65,  80,  96, 112, 128, 144,
+        160, 176, 176, 160, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,  32,  34,
+         13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 160, 176, 177, 162, 146,  99,
+    },
+    {
+         69,  54,  30,  26,  30,  16,  20,  29,  38,  41,  49,  61,  74,  88, 103, 118,
+        133, 148, 164, 180, 195, 211, 209, 193, 177, 161, 146, 130, 114,  99,  83,  68,
+         54,  40,  29,  25,  12,  20,  34,  49,  65,  80,  96, 112, 128, 144, 160, 176,
+        192, 208, 208, 192, 176, 160, 144, 128, 112,  96,  80,  64,  48,  32,   0,  13,
+         34,  49,  65,  81,  96, 112, 128, 144, 160, 176, 192, 208, 209, 193, 177, 130,
+    },
+    {
+         65,  49,  20,  13,  20,  20,  29,  41,  51,  53,  60,  70,  81,  94, 108, 123,
+        137, 152, 167, 183, 198, 214, 211, 195, 180, 164, 148, 133, 118, 103,  88,  74,
+         61,  49,  41,  38,  25,  29,  40,  54,  68,  83,  99, 114, 130, 146, 161, 177,
+        193, 209, 208, 192, 176, 160, 144, 128, 112,  96,  81,  65,  49,  34,  13,   0,
+         32,  48,  64,  80,  96, 112, 128, 144, 160, 176, 192, 208, 208, 192, 176, 128,
+    },
+    {
+         34,  20,  20,  34,  49,  49,  54,  61,  60,  53,  51,  53,  60,  70,  81,  94,
+        108, 123, 137, 152, 167, 183, 180, 164, 148, 133, 118, 103,  88,  74,  61,  49,
+         41,  38,  41,  49,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114, 130, 146,
+        161, 177, 176, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  34,  32,
+          0,  16,  32,  48,  64,  80,  96, 112, 128, 144, 160, 176, 176, 160, 144,  96,
+    },
+    {
+         20,  13,  34,  49,  65,  65,  68,  74,  70,  60,  53,  51,  53,  60,  70,  81,
+         94, 108, 123, 137, 152, 167, 164, 148, 133, 118, 103,  88,  74,  61,  49,  41,
+         38,  41,  49,  61,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114, 130,
+        146, 161, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  49,  48,
+         16,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144, 160, 160, 144, 128,  81,
+    },
+    {
+         13,  20,  49,  65,  81,  81,  83,  88,  81,  70,  60,  53,  51,  53,  60,  70,
+         81,  94, 108, 123, 137, 152, 148, 133, 118, 103,  88,  74,  61,  49,  41,  38,
+         41,  49,  61,  74,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99, 114,
+        130, 146, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  65,  64,
+         32,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128, 144, 144, 128, 112,  65,
+    },
+    {
+         20,  34,  65,  81,  96,  96,  99, 103,  94,  81,  70,  60,  53,  51,  53,  60,
+         70,  81,  94, 108, 123, 137, 133, 118, 103,  88,  74,  61,  49,  41,  38,  41,
+         49,  61,  74,  88,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83,  99,
+        114, 130, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  81,  80,
+         48,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112, 128, 128, 112,  96,  49,
+    },
+    {
+         34,  49,  81,  96, 112, 112, 114, 118, 108,  94,  81,  70,  60,  53,  51,  53,
+         60,  70,  81,  94, 108, 123, 118, 103,  88,  74,  61,  49,  41,  38,  41,  49,
+         61,  74,  88, 103,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,  83,
+         99, 114, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  96,  96,
+         64,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96, 112, 112,  96,  81,  34,
+    },
+    {
+         49,  65,  96, 112, 128, 128, 130, 133, 123, 108,  94,  81,  70,  60,  53,  51,
+         53,  60,  70,  81,  94, 108, 103,  88,  74,  61,  49,  41,  38,  41,  49,  61,
+         74,  88, 103, 118, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,  68,
+         83,  99,  96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81, 112, 112,
+         80,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80,  96,  96,  81,  65,  20,
+    },
+    {
+         65,  81, 112, 128, 144, 144, 146, 148, 137, 123, 108,  94,  81,  70,  60,  53,
+         51,  53,  60,  70,  81,  94,  88,  74,  61,  49,  41,  38,  41,  49,  61,  74,
+         88, 103, 118, 133, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,  54,
+         68,  83,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96, 128, 128,
+         96,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,  80,  81,  65,  49,  13,
+    },
+    {
+         81,  96, 128, 144, 160, 160, 161, 164, 152, 137, 123, 108,  94,  81,  70,  60,
+         53,  51,  53,  60,  70,  81,  74,  61,  49,  41,  38,  41,  49,  61,  74,  88,
+        103, 118, 133, 148, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,  40,
+         54,  68,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 144, 144,
+        112,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,  64,  65,  49,  34,  20,
+    },
+    {
+         96, 112, 144, 160, 176, 176, 177, 180, 167, 152, 137, 123, 108,  94,  81,  70,
+         60,  53,  51,  53,  60,  70,  61,  49,  41,  38,  41,  49,  61,  74,  88, 103,
+        118, 133, 148, 164, 161, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,  29,
+         40,  54,  49,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 160, 160,
+        128, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,  48,  49,  34,  20,  34,
+    },
+    {
+        112, 128, 160, 176, 192, 192, 193, 195, 183, 167, 152, 137, 123, 108,  94,  81,
+         70,  60,  53,  51,  53,  60,  49,  41,  38,  41,  49,  61,  74,  88, 103, 118,
+        133, 148, 164, 180, 177, 161, 146, 130, 114,  99,  83,  68,  54,  40,  29,  25,
+         29,  40,  34,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 176, 176,
+        144, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,  32,  34,  20,  13,  49,
+    },
+    {
+        128, 144, 176, 192, 208, 208, 209, 211, 198, 183, 167, 152, 137, 123, 108,  94,
+         81,  70,  60,  53,  51,  53,  41,  38,  41,  49,  61,  74,  88, 103, 118, 133,
+        148, 164, 180, 195, 193, 177, 161, 146, 130, 114,  99,  83,  68,  54,  40,  29,
+         25,  29,  20,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 160, 192, 192,
+        160, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,  16,  20,  13,  20,  65,
+    },
+    {
+        144, 160, 192, 208, 224, 224, 225, 227, 214, 198, 183, 167, 152, 137, 123, 108,
+         94,  81,  70,  60,  53,  51,  38,  41,  49,  61,  74,  88, 103, 118, 133, 148,
+        164, 180, 195, 211, 209, 193, 177, 161, 146, 130, 114,  99,  83,  68,  54,  40,
+         29,  25,  13,  20,  34,  49,  65,  81,  96, 112, 128, 144, 160, 176, 208, 208,
+        176, 160, 144, 128, 112,  96,  80,  64,  48,  32,  16,   0,  13,  20,  34,  81,
+    },
+    {
+        144, 160, 192, 208, 224, 225, 227, 229, 217, 202, 187, 172, 157, 143, 128, 115,
+        102,  90,  80,  71,  65,  64,  51,  53,  60,  70,  81,  94, 108, 123, 137, 152,
+        167, 183, 198, 214, 211, 195, 180, 164, 148, 133, 118, 103,  88,  74,  61,  49,
+         41,  38,  26,  30,  41,  54,  69,  84,  99, 114, 130, 146, 162, 177, 209, 208,
+        176, 160, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,   0,  16,  32,  80,
+    },
+    {
+        128, 144, 176, 192, 208, 209, 211, 214, 202, 187, 172, 157, 143, 128, 115, 102,
+         90,  80,  71,  65,  64,  65,  53,  51,  53,  60,  70,  81,  94, 108, 123, 137,
+        152, 167, 183, 198, 195, 180, 164, 148, 133, 118, 103,  88,  74,  61,  49,  41,
+         38,  41,  30,  26,  30,  41,  54,  69,  84,  99, 114, 130, 146, 162, 193, 192,
+        160, 144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  16,   0,  16,  64,
+    },
+    {
+        112, 128, 160, 176, 192, 193, 195, 198, 187, 172, 157, 143, 128, 115, 102,  90,
+         80,  71,  65,  64,  65,  71,  60,  53,  51,  53,  60,  70,  81,  94, 108, 123,
+        137, 152, 167, 183, 180, 164, 148, 133, 118, 103,  88,  74,  61,  49,  41,  38,
+         41,  49,  41,  30,  26,  30,  41,  54,  69,  84,  99, 114, 130, 146, 177, 176,
+        144, 128, 112,  96,  81,  65,  49,  34,  20,  13,  20,  34,  32,  16,   0,  48,
+    },
+    {
+         64,  80, 112, 128, 144, 146, 148, 152, 143, 128, 115, 102,  90,  80,  71,  65,
+         64,  65,  71,  80,  90, 102,  94,  81,  70,  60,  53,  51,  53,  60,  70,  81,
+         94, 108, 123, 137, 133, 118, 103,  88,  74,  61,  49,  41,  38,  41,  49,  61,
+         74,  88,  84,  69,  54,  41,  30,  26,  30,  41,  54,  69,  84,  99, 130, 128,
+         96,  81,  65,  49,  34,  20,  13,  20,  34,  49,  65,  81,  80,  64,  48,   0,
+    },
+};
@@ -0,0 +1,113 @@
+// Generated by tools/gen_led_layout.py from keyboard.json. Do not edit.
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#define LED_LAYOUT_COUNT 80
+#define LED_LAYOUT_ROWS 6
+#define LED_LAYOUT_COLS 15
+
+// LED index of the key at matrix position [row, col].
+#define LED_R5_C9 0
+#define LED_R5_C10 1
+#define LED_R5_C12 2
+#define LED_R5_C13 3
+#define LED_R5_C14 4
+#define LED_R3_C14 5
+#define LED_R2_C14 6
+#define LED_R1_C14 7
+#define LED_R0_C13 8
+#define LED_R0_C12 9
+#define LED_R0_C11 10
+#define LED_R0_C10 11
+#define LED_R0_C9 12
+#define LED_R0_C8 13
+#define LED_R0_C7 14
+#define LED_R0_C6 15
+#define LED_R0_C5 16
+#define LED_R0_C4 17
+#define LED_R0_C3 18
+#define LED_R0_C2 19
+#define LED_R0_C1 20
+#define LED_R0_C0 21
+#define LED_R1_C0 22
+#define LED_R1_C1 23
+#define LED_R1_C2 24
+#define LED_R1_C3 25
+#define LED_R1_C4 26
+#define LED_R1_C5 27
+#define LED_R1_C6 28
+#define LED_R1_C7 29
+#define LED_R1_C8 30
+#define LED_R1_C9 31
+#define LED_R1_C10 32
+#define LED_R1_C11 33
+#define LED_R1_C12 34
+#define LED_R1_C13 35
+#define LED_R2_C13 36
+#define LED_R2_C12 37
+#define LED_R2_C11 38
+#define LED_R2_C10 39
+#define LED_R2_C9 40
+#define LED_R2_C8 41
+#define LED_R2_C7 42
+#define LED_R2_C6 43
+#define LED_R2_C5 44
+#define LED_R2_C4 45
+#define LED_R2_C3 46
+#define LED_R2_C2 47
+#define LED_R2_C1 48
+#define LED_R2_C0 49
+#define LED_R3_C0 50
+#define LED_R3_C1 51
+#define LED_R3_C2 52
+#define LED_R3_C3 53
+#define LED_R3_C4 54
+#define LED_R3_C5 55
+#define LED_R3_C6 56
+#define LED_R3_C7 57
+#define LED_R3_C8 58
+#define LED_R3_C9 59
+#define LED_R3_C10 60
+#define LED_R3_C11 61
+#define LED_R3_C13 62
+#define LED_R4_C13 63
+#define LED_R4_C11 64
+#define LED_R4_C10 65
+#define LED_R4_C9 66
+#define LED_R4_C8 67
+#define LED_R4_C7 68
+#define LED_R4_C6 69
+#define LED_R4_C5 70
+#define LED_R4_C4 71
+#define LED_R4_C3 72
+#define LED_R4_C2 73
+#define LED_R4_C1 74
+#define LED_R4_C0 75
+#define LED_R5_C0 76
+#define LED_R5_C1 77
+#define LED_R5_C2 78
+#define LED_R5_C5 79
+
+// LED of each matrix position, NO_LED where the switch has none.
+extern const uint8_t matrix_to_led[LED_LAYOUT_ROWS][LED_LAYOUT_COLS];
+
+// Packed (row << 4) | col of each LED; LED_NO_KEY when it has no switch.
+#define LED_NO_KEY 0xFF
+#define LED_KEY_ROW(packed) ((packed) >> 4)
+#define LED_KEY_COL(packed) ((packed) & 0x0F)
+extern const uint8_t led_to_matrix[LED_LAYOUT_COUNT];
+
+// Nearest LED in each direction, NO_LED at the edge of the board.
+typedef enum {
+    LED_NEIGHBOR_LEFT = 0,
+    LED_NEIGHBOR_RIGHT,
+    LED_NEIGHBOR_UP,
+    LED_NEIGHBOR_DOWN,
+    LED_NEIGHBOR_COUNT,
+} led_neighbor_t;
+extern const uint8_t led_neighbors[LED_LAYOUT_COUNT][LED_NEIGHBOR_COUNT];
+
+// Integer distance between two LEDs in g_led_config units, as used by the
+// splash and reactive effects.
+extern const uint8_t led_distance[LED_LAYOUT_COUNT][LED_LAYOUT_COUNT];
@@ -0,0 +1,224 @@
+#include "light_stream.h"
+
+#include <string.h>
+#include "hid_commands.h"
+#include "rgb_driver.h"
+
+// Header of every frame packet: [seq, flags, ...].
+#define HEADER_SIZE 2
+
+static rgb_pixel_t frame[RGB_MATRIX_LED_COUNT];
+static rgb_pixel_t palette[LIGHT_STREAM_PALETTE_SIZE];
+static bool        active      = false;
+static uint8_t     next_seq    = 0;
+static uint32_t    last_packet = 0;
+static uint32_t    started_at  = 0;
+
+static struct {
+    uint32_t packets;
+    uint32_t frames;
+    uint32_t lost;     // sequence numbers skipped
+    uint32_t rejected; // malformed packets, not applied
+    uint32_t bytes;    // payload of accepted packets
+    uint32_t active_ms;
+    uint32_t stale; // repeated or overtaken packets, not applied
+} stats;
+
+static rgb_pixel_t read_rgb(const uint8_t *data) {
+    return RGB_PIXEL(data[0], data[1], data[2]);
+}
+
+static void account_active(void) {
+    uint32_t now = timer_read32();
+    stats.active_ms += TIMER_DIFF_32(now, started_at);
+    started_at = now;
+}
+
+static void stop(void) {
+    if (active) {
+        account_active();
+        active = false;
+        rgb_driver_release_external(RGB_DRIVER_EXTERNAL_LIGHT_STREAM);
+    }
+}
+
+// The host picks the colours; only the board's brightness cap still applies.
+// The driver keeps showing `capped` after game mode takes the LEDs back from
+// a lower owner, so it outlives the call.
+static void show(void) {
+    static rgb_pixel_t capped[RGB_MATRIX_LED_COUNT];
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        capped[i] = rgb_pixel_scale_div(frame[i], RGB_MATRIX_MAXIMUM_BRIGHTNESS, 255);
+    }
+    rgb_driver_write_external(RGB_DRIVER_EXTERNAL_LIGHT_STREAM, capped);
+    stats.frames++;
+}
+
+static bool apply_full(const uint8_t *body, uint8_t size) {
+    uint8_t first = body[0];
+    uint8_t count = body[1];
+    if (size < 2 + count * 3 || first >= RGB_MATRIX_LED_COUNT || count > RGB_MATRIX_LED_COUNT - first) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        frame[first + i] = read_rgb(&body[2 + i * 3]);
+    }
+    return true;
+}
+
+static bool apply_delta(const uint8_t *body, uint8_t size) {
+    uint8_t count = body[0];
+    if (size < 1 + count * 4) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (body[1 + i * 4] >= RGB_MATRIX_LED_COUNT) {
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        frame[body[1 + i * 4]] = read_rgb(&body[2 + i * 4]);
+    }
+    return true;
+}
+
+static bool apply_palette(const uint8_t *body, uint8_t size) {
+    uint8_t first = body[0];
+    uint8_t count = body[1];
+    if (size < 2 + count * 3 || first >= LIGHT_STREAM_PALETTE_SIZE || count > LIGHT_STREAM_PALETTE_SIZE - first) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        palette[first + i] = read_rgb(&body[2 + i * 3]);
+    }
+    return true;
+}
+
+// Two LEDs per byte, the lower-numbered one in the low nibble.
+static bool apply_indexed(const uint8_t *body, uint8_t size) {
+    uint8_t first = body[0];
+    uint8_t count = body[1];
+    if (size < 2 + (count + 1) / 2 || first >= RGB_MATRIX_LED_COUNT || count > RGB_MATRIX_LED_COUNT - first) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t packed = body[2 + i / 2];
+        frame[first + i] = palette[(i & 1) ? packed >> 4 : packed & 0x0F];
+    }
+    return true;
+}
+
+// Reply: [.., .., op, seq, accepted]
+static void frame_packet(uint8_t op, uint8_t *payload, uint8_t size) {
+    uint8_t seq   = payload[0];
+    uint8_t flags = payload[1];
+    bool    accepted;
+
+    // Sequence numbers wrap at 256; up to 127 behind the expected one is a
+    // repeat or a packet overtaken by newer ones, whose pixels are stale.
+    int8_t ahead = (int8_t)(seq - next_seq);
+    if (active && ahead < 0) {
+        last_packet = timer_read32();
+        stats.packets++;
+        stats.stale++;
+        payload[1] = false;
+        return;
+    }
+
+    switch (op) {
+        case LIGHT_STREAM_OP_FULL:
+            accepted = apply_full(&payload[HEADER_SIZE], size - HEADER_SIZE);
+            break;
+        case LIGHT_STREAM_OP_DELTA:
+            accepted = apply_delta(&payload[HEADER_SIZE], size - HEADER_SIZE);
+            break;
+        case LIGHT_STREAM_OP_PALETTE:
+            accepted = apply_palette(&payload[HEADER_SIZE], size - HEADER_SIZE);
+            break;
+        default:
+            accepted = apply_indexed(&payload[HEADER_SIZE], size - HEADER_SIZE);
+            break;
+    }
+
+    if (!active) {
+        active     = true;
+        started_at = timer_read32();
+        rgb_driver_take_external(RGB_DRIVER_EXTERNAL_LIGHT_STREAM);
+    } else {
+        stats.lost += ahead;
+    }
+    next_seq    = seq + 1;
+    last_packet = timer_read32();
+    stats.packets++;
+
+    if (accepted) {
+        stats.bytes += size;
+        if (flags & LIGHT_STREAM_FLAG_SHOW) {
+            show();
+        }
+    } else {
+        stats.rejected++;
+    }
+    payload[1] = accepted;
+}
+
+void light_stream_task(void) {
+    if (active && timer_elapsed32(last_packet) >= LIGHT_STREAM_TIMEOUT_MS) {
+        stop();
+    }
+}
+
+// Request:  [cmd, subsystem, op, ...]
+// INFO:     [.., .., op, led_count, palette_size, active, timeout_ms(2)]
+// FULL:     [.., .., op, seq, flags, first, count, (r, g, b) * count]
+// DELTA:    [.., .., op, seq, flags, count, (led, r, g, b) * count]
+// PALETTE:  [.., .., op, seq, flags, first, count, (r, g, b) * count]
+// INDEXED:  [.., .., op, seq, flags, first, count, index nibbles]
+// STATS:    [.., .., op, active, packets(4), frames(4), lost(4), rejected(4), bytes(4), active_ms(4), stale(4)]
+void light_stream_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    uint8_t  size    = length > 3 ? length - 3 : 0;
+    switch (data[2]) {
+        case LIGHT_STREAM_OP_INFO:
+            payload[0] = RGB_MATRIX_LED_COUNT;
+            payload[1] = LIGHT_STREAM_PALETTE_SIZE;
+            payload[2] = active;
+            pwx_hid_write_u16(&payload[3], LIGHT_STREAM_TIMEOUT_MS);
+            break;
+        case LIGHT_STREAM_OP_FULL:
+        case LIGHT_STREAM_OP_DELTA:
+        case LIGHT_STREAM_OP_PALETTE:
+        case LIGHT_STREAM_OP_INDEXED:
+            if (size < HEADER_SIZE + 1) {
+                stats.rejected++;
+                break;
+            }
+            frame_packet(data[2], payload, size);
+            break;
+        case LIGHT_STREAM_OP_STOP:
+            stop();
+            break;
+        case LIGHT_STREAM_OP_STATS:
+            if (active) {
+                account_active();
+            }
+            payload[0] = active;
+            pwx_hid_write_u32(&payload[1], stats.packets);
+            pwx_hid_write_u32(&payload[5], stats.frames);
+            pwx_hid_write_u32(&payload[9], stats.lost);
+            pwx_hid_write_u32(&payload[13], stats.rejected);
+            pwx_hid_write_u32(&payload[17], stats.bytes);
+            pwx_hid_write_u32(&payload[21], stats.active_ms);
+            pwx_hid_write_u32(&payload[25], stats.stale);
+            break;
+        case LIGHT_STREAM_OP_RESET:
+            if (active) {
+                account_active();
+            }
+            memset(&stats, 0, sizeof(stats));
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Live lighting from the host over raw HID. Frame packets build a frame in
+// RAM, and a packet flagged LIGHT_STREAM_FLAG_SHOW puts it on the LEDs
+// through the RGB driver, which ignores the RGB matrix while a stream is
+// active. A frame can be sent in three ways, freely mixed:
+//
+//   FULL     8 LEDs of RGB per packet; 10 packets for the whole board
+//   DELTA    up to 6 (LED, RGB) pairs per packet, for sparse changes
+//   INDEXED  4-bit indices into a 16-colour palette set with PALETTE;
+//            50 LEDs per packet, so 2 packets for the whole board
+//
+// At one report per 1 ms USB poll, that is 60 fps even when every frame is sent
+// in FULL. Every packet carries a sequence number. Gaps are counted as lost
+// packets, and a packet that repeats or is older than the last one is dropped
+// as stale, so a late packet never puts old pixels back. The stream ends on
+// STOP or LIGHT_STREAM_TIMEOUT_MS after the last packet, and the RGB matrix, or
+// game mode's frame, takes over again. A stream shows over game mode's frame
+// while it lasts.
+// tools/light_stream.py is the host side.
+
+#ifndef LIGHT_STREAM_TIMEOUT_MS
+#    define LIGHT_STREAM_TIMEOUT_MS 1000
+#endif
+
+#define LIGHT_STREAM_PALETTE_SIZE 16
+#define LIGHT_STREAM_FLAG_SHOW 0x01
+
+typedef enum {
+    LIGHT_STREAM_OP_INFO = 0x00,
+    LIGHT_STREAM_OP_FULL,
+    LIGHT_STREAM_OP_DELTA,
+    LIGHT_STREAM_OP_PALETTE,
+    LIGHT_STREAM_OP_INDEXED,
+    LIGHT_STREAM_OP_STOP,
+    LIGHT_STREAM_OP_STATS,
+    LIGHT_STREAM_OP_RESET,
+} light_stream_op_t;
+
+void light_stream_task(void);
+void light_stream_hid_command(uint8_t *data, uint8_t length);
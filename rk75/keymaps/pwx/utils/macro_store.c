@@ -0,0 +1,537 @@
+#include "macro_store.h"
+
+#include <string.h>
+#include "action_util.h"
+#include "flash_spi.h"
+#include "event_trace.h"
+#include "key_time.h"
+#include "hid_commands.h"
+
+#ifndef MACRO_STORE_FLASH_ADDRESS
+#    error "macro_store: MACRO_STORE_FLASH_ADDRESS must point at a free flash region"
+#endif
+#ifndef MACRO_STORE_FLASH_SECTORS
+#    define MACRO_STORE_FLASH_SECTORS 8
+#endif
+
+_Static_assert(MACRO_STORE_FLASH_ADDRESS >= EXTERNAL_FLASH_BLOCK_SIZE, "macro_store: the first flash block is erased by wear-leveling compactions");
+
+// Reports are paced on the microsecond clock: with whole milliseconds, two
+// reports on either side of a tick could land in the same host poll and the
+// first would be overwritten before the host read it.
+#define MACRO_STORE_REPORT_US ((uint32_t)MACRO_STORE_REPORT_MS * 1000)
+
+// Every sector opens with a header carrying a sequence number that grows by
+// one per sector opened, which gives the replay order after a reset. Records
+// follow back to back, 4-byte aligned, until the first erased header.
+#define MACRO_STORE_SECTOR_MAGIC 0x5253434D // "MCSR"
+#define MACRO_STORE_RECORD_MAGIC 0x4352     // "RC"
+#define MACRO_STORE_ERASED_MAGIC 0xFFFF
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+} macro_store_sector_header_t;
+
+typedef struct {
+    uint16_t magic;
+    uint8_t  slot;
+    uint8_t  reserved;
+    uint16_t length; // 0 marks a deleted slot
+    uint16_t checksum;
+} macro_store_record_header_t;
+
+#define MACRO_STORE_RECORD_SPAN(length) ((sizeof(macro_store_record_header_t) + (length) + 3u) & ~3u)
+#define MACRO_STORE_SECTOR_PAYLOAD (EXTERNAL_FLASH_SECTOR_SIZE - sizeof(macro_store_sector_header_t))
+
+// Opening a sector moves the live records of the oldest one into it, so every
+// slot at full length plus the copy being replaced must fit in the sectors
+// left once one is free and one is being reclaimed.
+_Static_assert(MACRO_STORE_FLASH_SECTORS >= 3, "macro_store: at least three sectors are needed");
+_Static_assert(MACRO_STORE_SLOTS < 255, "macro_store: slot numbers must fit a byte");
+_Static_assert((MACRO_STORE_SLOTS + 1) * MACRO_STORE_RECORD_SPAN(MACRO_STORE_MAX_LENGTH) <= (MACRO_STORE_FLASH_SECTORS - 2) * MACRO_STORE_SECTOR_PAYLOAD, "macro_store: snippets do not fit the flash region");
+
+// US layout; MACRO_STORE_SHIFT marks characters typed with Shift held.
+#define MACRO_STORE_SHIFT 0x80
+
+static const uint8_t ascii_to_hid_table[128] = {
+    ['\t'] = KC_TAB,
+    ['\n'] = KC_ENTER,
+    [' ']  = KC_SPACE,
+    ['!']  = MACRO_STORE_SHIFT | KC_1,
+    ['"']  = MACRO_STORE_SHIFT | KC_QUOTE,
+    ['#']  = MACRO_STORE_SHIFT | KC_3,
+    ['$']  = MACRO_STORE_SHIFT | KC_4,
+    ['%']  = MACRO_STORE_SHIFT | KC_5,
+    ['&']  = MACRO_STORE_SHIFT | KC_7,
+    ['\''] = KC_QUOTE,
+    ['(']  = MACRO_STORE_SHIFT | KC_9,
+    [')']  = MACRO_STORE_SHIFT | KC_0,
+    ['*']  = MACRO_STORE_SHIFT | KC_8,
+    ['+']  = MACRO_STORE_SHIFT | KC_EQUAL,
+    [',']  = KC_COMMA,
+    ['-']  = KC_MINUS,
+    ['.']  = KC_DOT,
+    ['/']  = KC_SLASH,
+    ['0']  = KC_0,
+    [':']  = MACRO_STORE_SHIFT | KC_SEMICOLON,
+    [';']  = KC_SEMICOLON,
+    ['<']  = MACRO_STORE_SHIFT | KC_COMMA,
+    ['=']  = KC_EQUAL,
+    ['>']  = MACRO_STORE_SHIFT | KC_DOT,
+    ['?']  = MACRO_STORE_SHIFT | KC_SLASH,
+    ['@']  = MACRO_STORE_SHIFT | KC_2,
+    ['[']  = KC_LEFT_BRACKET,
+    ['\\'] = KC_BACKSLASH,
+    [']']  = KC_RIGHT_BRACKET,
+    ['^']  = MACRO_STORE_SHIFT | KC_6,
+    ['_']  = MACRO_STORE_SHIFT | KC_MINUS,
+    ['`']  = KC_GRAVE,
+    ['{']  = MACRO_STORE_SHIFT | KC_LEFT_BRACKET,
+    ['|']  = MACRO_STORE_SHIFT | KC_BACKSLASH,
+    ['}']  = MACRO_STORE_SHIFT | KC_RIGHT_BRACKET,
+    ['~']  = MACRO_STORE_SHIFT | KC_GRAVE,
+};
+
+static uint32_t sector_sequence[MACRO_STORE_FLASH_SECTORS]; // 0 for sectors not in use
+static uint32_t next_sequence = 1;
+static uint8_t  head_sector   = MACRO_STORE_FLASH_SECTORS - 1;
+static uint16_t head_offset   = EXTERNAL_FLASH_SECTOR_SIZE;
+
+static uint32_t slot_address[MACRO_STORE_SLOTS]; // record header, 0 for an empty slot
+static uint16_t slot_length[MACRO_STORE_SLOTS];
+
+static uint8_t chunk[64];
+
+static uint8_t  staging[MACRO_STORE_MAX_LENGTH];
+static uint8_t  staging_slot   = 0xFF;
+static uint16_t staging_length = 0;
+
+static struct {
+    bool     active;
+    bool     shifted;
+    bool     caps_lock;
+    uint8_t  slot;
+    uint8_t  held;
+    uint8_t  position;
+    uint8_t  buffered;
+    uint16_t remaining;
+    uint32_t last_report; // key_time_now_us()
+    uint32_t address;
+    uint8_t  buffer[32];
+} playback;
+
+static uint32_t sector_address(uint8_t sector) {
+    return MACRO_STORE_FLASH_ADDRESS + (uint32_t)sector * EXTERNAL_FLASH_SECTOR_SIZE;
+}
+
+static uint32_t fnv1a(uint32_t hash, const uint8_t *bytes, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t checksum_begin(uint8_t slot, uint16_t length) {
+    uint8_t fields[3] = {slot, length & 0xFF, length >> 8};
+    return fnv1a(2166136261u, fields, sizeof(fields));
+}
+
+static uint16_t checksum_end(uint32_t hash) {
+    return (hash >> 16) ^ (hash & 0xFFFF);
+}
+
+static bool record_is_intact(uint32_t address, const macro_store_record_header_t *header) {
+    uint32_t hash = checksum_begin(header->slot, header->length);
+    uint32_t data = address + sizeof(*header);
+    for (uint16_t done = 0; done < header->length;) {
+        uint16_t count = header->length - done;
+        if (count > sizeof(chunk)) {
+            count = sizeof(chunk);
+        }
+        if (flash_read_block(data + done, chunk, count) != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+        hash = fnv1a(hash, chunk, count);
+        done += count;
+    }
+    return checksum_end(hash) == header->checksum;
+}
+
+static void index_record(uint32_t address, const macro_store_record_header_t *header) {
+    if (header->slot >= MACRO_STORE_SLOTS) {
+        return;
+    }
+    slot_address[header->slot] = header->length ? address : 0;
+    slot_length[header->slot]  = header->length;
+}
+
+// Indexes the records of one sector and returns the offset new records would
+// be appended at. A damaged record ends the sector: nothing more is written
+// to it and it is reclaimed in turn like any other.
+static uint16_t scan_sector(uint8_t sector) {
+    uint32_t base   = sector_address(sector);
+    uint16_t offset = sizeof(macro_store_sector_header_t);
+    while (offset + sizeof(macro_store_record_header_t) <= EXTERNAL_FLASH_SECTOR_SIZE) {
+        macro_store_record_header_t header;
+        if (flash_read_block(base + offset, &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+            return EXTERNAL_FLASH_SECTOR_SIZE;
+        }
+        if (header.magic == MACRO_STORE_ERASED_MAGIC) {
+            return offset;
+        }
+        if (header.magic != MACRO_STORE_RECORD_MAGIC || offset + MACRO_STORE_RECORD_SPAN(header.length) > EXTERNAL_FLASH_SECTOR_SIZE) {
+            return EXTERNAL_FLASH_SECTOR_SIZE;
+        }
+        if (!record_is_intact(base + offset, &header)) {
+            return EXTERNAL_FLASH_SECTOR_SIZE;
+        }
+        index_record(base + offset, &header);
+        offset += MACRO_STORE_RECORD_SPAN(header.length);
+    }
+    return EXTERNAL_FLASH_SECTOR_SIZE;
+}
+
+static bool sector_has_live_records(uint8_t sector) {
+    uint32_t base = sector_address(sector);
+    for (uint8_t slot = 0; slot < MACRO_STORE_SLOTS; slot++) {
+        if (slot_address[slot] >= base && slot_address[slot] < base + EXTERNAL_FLASH_SECTOR_SIZE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool copy_to_head(uint32_t source, uint16_t span) {
+    uint32_t target = sector_address(head_sector) + head_offset;
+    event_trace(EVENT_TRACE_FLASH, EVENT_TRACE_FLASH_ARG(EVENT_TRACE_SOURCE_MACRO_STORE, EVENT_TRACE_FLASH_PROGRAM));
+    for (uint16_t done = 0; done < span;) {
+        uint16_t count = span - done;
+        if (count > sizeof(chunk)) {
+            count = sizeof(chunk);
+        }
+        if (flash_read_block(source + done, chunk, count) != FLASH_STATUS_SUCCESS || flash_write_block(target + done, chunk, count) != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+        done += count;
+    }
+    return true;
+}
+
+// Moves the live records of a sector into the head so the sector holds only
+// superseded data by the time it is erased.
+static bool evacuate_sector(uint8_t sector) {
+    uint32_t base = sector_address(sector);
+    for (uint8_t slot = 0; slot < MACRO_STORE_SLOTS; slot++) {
+        if (slot_address[slot] < base || slot_address[slot] >= base + EXTERNAL_FLASH_SECTOR_SIZE) {
+            continue;
+        }
+        uint16_t span = MACRO_STORE_RECORD_SPAN(slot_length[slot]);
+        if (head_offset + span > EXTERNAL_FLASH_SECTOR_SIZE) {
+            return false;
+        }
+        uint32_t target = sector_address(head_sector) + head_offset;
+        bool     copied = copy_to_head(slot_address[slot], span);
+        head_offset += span; // consumed even on failure, like any other append
+        if (!copied) {
+            return false;
+        }
+        slot_address[slot] = target;
+    }
+    return true;
+}
+
+static bool open_next_sector(void) {
+    uint8_t sector = (head_sector + 1) % MACRO_STORE_FLASH_SECTORS;
+    if (sector_has_live_records(sector)) {
+        return false;
+    }
+    macro_store_sector_header_t header = {MACRO_STORE_SECTOR_MAGIC, next_sequence};
+    event_trace(EVENT_TRACE_FLASH, EVENT_TRACE_FLASH_ARG(EVENT_TRACE_SOURCE_MACRO_STORE, EVENT_TRACE_FLASH_ERASE));
+    if (flash_erase_sector(sector_address(sector)) != FLASH_STATUS_SUCCESS || flash_write_block(sector_address(sector), &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    sector_sequence[sector] = next_sequence++;
+    head_sector             = sector;
+    head_offset             = sizeof(header);
+    return evacuate_sector((sector + 1) % MACRO_STORE_FLASH_SECTORS);
+}
+
+static bool reserve(uint16_t span) {
+    for (uint8_t i = 0; i < MACRO_STORE_FLASH_SECTORS && head_offset + span > EXTERNAL_FLASH_SECTOR_SIZE; i++) {
+        if (!open_next_sector()) {
+            return false;
+        }
+    }
+    return head_offset + span <= EXTERNAL_FLASH_SECTOR_SIZE;
+}
+
+static bool append_record(uint8_t slot, const uint8_t *text, uint16_t length) {
+    uint16_t span = MACRO_STORE_RECORD_SPAN(length);
+    if (!reserve(span)) {
+        return false;
+    }
+
+    macro_store_record_header_t header = {
+        .magic    = MACRO_STORE_RECORD_MAGIC,
+        .slot     = slot,
+        .reserved = 0xFF,
+        .length   = length,
+        .checksum = checksum_end(fnv1a(checksum_begin(slot, length), text, length)),
+    };
+    uint32_t address = sector_address(head_sector) + head_offset;
+    head_offset += span;
+    event_trace(EVENT_TRACE_FLASH, EVENT_TRACE_FLASH_ARG(EVENT_TRACE_SOURCE_MACRO_STORE, EVENT_TRACE_FLASH_PROGRAM));
+    if (flash_write_block(address, &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    if (length > 0 && flash_write_block(address + sizeof(header), text, length) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    index_record(address, &header);
+    return true;
+}
+
+void macro_store_load(void) {
+    memset(slot_address, 0, sizeof(slot_address));
+    memset(slot_length, 0, sizeof(slot_length));
+    for (uint8_t sector = 0; sector < MACRO_STORE_FLASH_SECTORS; sector++) {
+        macro_store_sector_header_t header;
+        sector_sequence[sector] = 0;
+        if (flash_read_block(sector_address(sector), &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+            continue;
+        }
+        if (header.magic == MACRO_STORE_SECTOR_MAGIC && header.sequence != 0 && header.sequence != UINT32_MAX) {
+            sector_sequence[sector] = header.sequence;
+        }
+    }
+
+    // Replay oldest first so newer records replace older ones in the index.
+    uint32_t replayed = 0;
+    head_sector       = MACRO_STORE_FLASH_SECTORS - 1;
+    head_offset       = EXTERNAL_FLASH_SECTOR_SIZE;
+    for (;;) {
+        uint8_t oldest = MACRO_STORE_FLASH_SECTORS;
+        for (uint8_t sector = 0; sector < MACRO_STORE_FLASH_SECTORS; sector++) {
+            if (sector_sequence[sector] > replayed && (oldest == MACRO_STORE_FLASH_SECTORS || sector_sequence[sector] < sector_sequence[oldest])) {
+                oldest = sector;
+            }
+        }
+        if (oldest == MACRO_STORE_FLASH_SECTORS) {
+            break;
+        }
+        replayed    = sector_sequence[oldest];
+        head_sector = oldest;
+        head_offset = scan_sector(oldest);
+    }
+    next_sequence = replayed + 1;
+
+    // Power lost while a sector was being reclaimed leaves live records in
+    // the sector after the head; finish moving them.
+    if (replayed != 0) {
+        evacuate_sector((head_sector + 1) % MACRO_STORE_FLASH_SECTORS);
+    }
+}
+
+uint16_t macro_store_length(uint8_t slot) {
+    return slot < MACRO_STORE_SLOTS ? slot_length[slot] : 0;
+}
+
+bool macro_store_write(uint8_t slot, const uint8_t *text, uint16_t length) {
+    if (slot >= MACRO_STORE_SLOTS || length > MACRO_STORE_MAX_LENGTH) {
+        return false;
+    }
+    // Appending may relocate records, so nothing may be read from flash mid-write.
+    macro_store_stop();
+    return append_record(slot, text, length);
+}
+
+bool macro_store_delete(uint8_t slot) {
+    if (slot >= MACRO_STORE_SLOTS) {
+        return false;
+    }
+    if (slot_length[slot] == 0) {
+        return true;
+    }
+    return macro_store_write(slot, NULL, 0);
+}
+
+static uint8_t ascii_to_hid(uint8_t c) {
+    if (c >= 'a' && c <= 'z') {
+        return (playback.caps_lock ? MACRO_STORE_SHIFT : 0) | (KC_A + (c - 'a'));
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return (playback.caps_lock ? 0 : MACRO_STORE_SHIFT) | (KC_A + (c - 'A'));
+    }
+    if (c >= '1' && c <= '9') {
+        return KC_1 + (c - '1');
+    }
+    return c < sizeof(ascii_to_hid_table) ? ascii_to_hid_table[c] : 0;
+}
+
+bool macro_store_play(uint8_t slot) {
+    if (slot >= MACRO_STORE_SLOTS || slot_length[slot] == 0) {
+        return false;
+    }
+    macro_store_stop();
+    playback.active      = true;
+    playback.slot        = slot;
+    playback.caps_lock   = host_keyboard_led_state().caps_lock;
+    playback.address     = slot_address[slot] + sizeof(macro_store_record_header_t);
+    playback.remaining   = slot_length[slot];
+    playback.position    = 0;
+    playback.buffered    = 0;
+    playback.last_report = key_time_now_us() - MACRO_STORE_REPORT_US;
+    return true;
+}
+
+bool macro_store_playing(void) {
+    return playback.active;
+}
+
+void macro_store_stop(void) {
+    if (!playback.active) {
+        return;
+    }
+    if (playback.held != KC_NO) {
+        del_key(playback.held);
+    }
+    if (playback.shifted) {
+        del_weak_mods(MOD_BIT(KC_LEFT_SHIFT));
+    }
+    send_keyboard_report();
+    playback.held    = KC_NO;
+    playback.shifted = false;
+    playback.active  = false;
+}
+
+// Returns the next character that has a key, 0 once the snippet is exhausted.
+static uint8_t playback_peek(void) {
+    while (playback.remaining > 0) {
+        if (playback.position == playback.buffered) {
+            uint8_t count = playback.remaining < sizeof(playback.buffer) ? playback.remaining : sizeof(playback.buffer);
+            if (flash_read_block(playback.address, playback.buffer, count) != FLASH_STATUS_SUCCESS) {
+                return 0;
+            }
+            playback.address += count;
+            playback.buffered = count;
+            playback.position = 0;
+        }
+        uint8_t code = ascii_to_hid(playback.buffer[playback.position]);
+        if (code != 0) {
+            return code;
+        }
+        playback.position++;
+        playback.remaining--;
+    }
+    return 0;
+}
+
+// One report per call. Moving from one key to another with the same shift
+// state is a single report; a repeated key or a shift change first releases
+// the held key (and switches shift in that same report), then presses.
+void macro_store_task(void) {
+    if (!playback.active || TIMER_DIFF_32(key_time_now_us(), playback.last_report) < MACRO_STORE_REPORT_US) {
+        return;
+    }
+    uint8_t code = playback_peek();
+    if (code == 0) {
+        macro_store_stop();
+        return;
+    }
+    uint8_t key     = code & ~MACRO_STORE_SHIFT;
+    bool    shifted = code & MACRO_STORE_SHIFT;
+
+    bool release = playback.held != KC_NO && (playback.held == key || playback.shifted != shifted);
+    if (release) {
+        del_key(playback.held);
+        playback.held = KC_NO;
+    }
+    if (playback.shifted != shifted) {
+        if (shifted) {
+            add_weak_mods(MOD_BIT(KC_LEFT_SHIFT));
+        } else {
+            del_weak_mods(MOD_BIT(KC_LEFT_SHIFT));
+        }
+        playback.shifted = shifted;
+    } else if (!release) {
+        if (playback.held != KC_NO) {
+            del_key(playback.held);
+        }
+        add_key(key);
+        playback.held = key;
+        playback.position++;
+        playback.remaining--;
+    }
+    send_keyboard_report();
+    playback.last_report = key_time_now_us();
+}
+
+// Request:     [cmd, subsystem, op, args...]
+// INFO:        [.., .., op, slots, max_lo, max_hi, playing, length_lo, length_hi, ...]
+// READ:        [.., .., op, slot, offset_lo, offset_hi, count, bytes...]
+// WRITE_BEGIN: [.., .., op, slot, length_lo, length_hi] -> [.., .., op, ok]
+// WRITE_DATA:  [.., .., op, offset_lo, offset_hi, count, bytes...] -> [.., .., op, ok]
+// WRITE_COMMIT, DELETE [slot], PLAY [slot] -> [.., .., op, ok]
+void macro_store_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case MACRO_STORE_OP_INFO: {
+            payload[0] = MACRO_STORE_SLOTS;
+            pwx_hid_write_u16(&payload[1], MACRO_STORE_MAX_LENGTH);
+            payload[3] = playback.active ? playback.slot : 0xFF;
+            for (uint8_t slot = 0; slot < MACRO_STORE_SLOTS && 3 + 4 + (slot + 1) * 2 <= length; slot++) {
+                pwx_hid_write_u16(&payload[4 + slot * 2], slot_length[slot]);
+            }
+            break;
+        }
+        case MACRO_STORE_OP_READ: {
+            uint8_t  slot   = payload[0];
+            uint16_t offset = pwx_hid_read_u16(&payload[1]);
+            uint8_t  count  = length - 7;
+            uint16_t total  = macro_store_length(slot);
+            if (offset >= total) {
+                count = 0;
+            } else if (count > total - offset) {
+                count = total - offset;
+            }
+            if (count > 0 && flash_read_block(slot_address[slot] + sizeof(macro_store_record_header_t) + offset, &payload[4], count) != FLASH_STATUS_SUCCESS) {
+                count = 0;
+            }
+            payload[3] = count;
+            break;
+        }
+        case MACRO_STORE_OP_WRITE_BEGIN: {
+            uint16_t size  = pwx_hid_read_u16(&payload[1]);
+            bool     valid = payload[0] < MACRO_STORE_SLOTS && size <= MACRO_STORE_MAX_LENGTH;
+            staging_slot   = valid ? payload[0] : 0xFF;
+            staging_length = valid ? size : 0;
+            payload[0]     = valid;
+            break;
+        }
+        case MACRO_STORE_OP_WRITE_DATA: {
+            uint16_t offset = pwx_hid_read_u16(&payload[0]);
+            uint8_t  count  = payload[2];
+            bool     valid  = staging_slot != 0xFF && count <= length - 6 && offset + count <= staging_length;
+            if (valid) {
+                memcpy(&staging[offset], &payload[3], count);
+            }
+            payload[0] = valid;
+            break;
+        }
+        case MACRO_STORE_OP_WRITE_COMMIT:
+            payload[0]   = staging_slot != 0xFF && macro_store_write(staging_slot, staging, staging_length);
+            staging_slot = 0xFF;
+            break;
+        case MACRO_STORE_OP_DELETE:
+            payload[0] = macro_store_delete(payload[0]);
+            break;
+        case MACRO_STORE_OP_PLAY:
+            payload[0] = macro_store_play(payload[0]);
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include <stdbool.h>
+
+// Text snippets kept in a log-structured region of the external SPI flash.
+// Each write appends a new record for its slot and the newest one wins; whole
+// sectors are reclaimed in ring order once their records have been superseded.
+// Playback types a snippet one HID report per host poll, without blocking.
+
+#ifndef MACRO_STORE_SLOTS
+#    define MACRO_STORE_SLOTS 8
+#endif
+
+// Longest snippet accepted, in characters. Uploads are staged in RAM.
+#ifndef MACRO_STORE_MAX_LENGTH
+#    define MACRO_STORE_MAX_LENGTH 1024
+#endif
+
+// Minimum time between two keyboard reports during playback. The default
+// matches the interval the host polls the keyboard endpoint at, so every
+// report is picked up before the next one replaces it.
+#ifndef MACRO_STORE_REPORT_MS
+#    ifdef USB_POLLING_INTERVAL_MS
+#        define MACRO_STORE_REPORT_MS USB_POLLING_INTERVAL_MS
+#    else
+#        define MACRO_STORE_REPORT_MS 1
+#    endif
+#endif
+
+typedef enum {
+    MACRO_STORE_OP_INFO = 0x00,
+    MACRO_STORE_OP_READ,
+    MACRO_STORE_OP_WRITE_BEGIN,
+    MACRO_STORE_OP_WRITE_DATA,
+    MACRO_STORE_OP_WRITE_COMMIT,
+    MACRO_STORE_OP_DELETE,
+    MACRO_STORE_OP_PLAY,
+} macro_store_op_t;
+
+void     macro_store_load(void);
+uint16_t macro_store_length(uint8_t slot);
+bool     macro_store_write(uint8_t slot, const uint8_t *text, uint16_t length);
+bool     macro_store_delete(uint8_t slot);
+bool     macro_store_play(uint8_t slot);
+bool     macro_store_playing(void);
+void     macro_store_stop(void);
+void     macro_store_task(void);
+void     macro_store_hid_command(uint8_t *data, uint8_t length);
@@ -0,0 +1,173 @@
+#include "matrix_scan.h"
+
+#include <string.h>
+#include "matrix.h"
+#include "event_trace.h"
+#include "key_time.h"
+#if defined(SCAN_THREAD_ENABLE)
+#    include "scan_thread.h"
+#endif
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static bool          parked          = false;
+static volatile bool wake_pending    = false;
+static uint32_t      last_key_active = 0;
+static uint32_t      sample_us       = 0;
+
+static void select_col(uint8_t col) {
+    gpio_set_pin_output(col_pins[col]);
+    gpio_write_pin_low(col_pins[col]);
+}
+
+static void unselect_col(uint8_t col) {
+    gpio_set_pin_input_high(col_pins[col]);
+}
+
+static bool any_row_low(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (!gpio_read_pin(row_pins[row])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void row_edge_callback(void *arg) {
+    (void)arg;
+    wake_pending = true;
+#if defined(SCAN_THREAD_ENABLE)
+    scan_thread_wake_from_isr();
+#endif
+}
+
+// The diodes point from row to column, so a driven column pulls the row of any
+// pressed key low. Driving every column at once turns the six row inputs into
+// a single "any key" detector; rows sit on EXTI lines 0-4 and 13, which
+// collide neither with each other nor with the encoder on lines 6 and 7.
+static void matrix_park(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+    matrix_output_select_delay();
+    wake_pending = false;
+    // palDisableLineEvent() also clears a line's callback, so it is set again
+    // every time the lines are armed.
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        palSetLineCallback(row_pins[row], row_edge_callback, NULL);
+        palEnableLineEvent(row_pins[row], PAL_EVENT_MODE_FALLING_EDGE);
+    }
+    parked = true;
+    // A key that went down while arming produced no edge; catch it here.
+    if (any_row_low()) {
+        wake_pending = true;
+    }
+}
+
+static void matrix_unpark(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        palDisableLineEvent(row_pins[row]);
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        unselect_col(col);
+    }
+    matrix_output_unselect_delay(0, true);
+    parked       = false;
+    wake_pending = false;
+}
+
+static bool read_rows_on_col(matrix_row_t current_matrix[], uint8_t col) {
+    bool         key_pressed = false;
+    matrix_row_t col_mask    = MATRIX_ROW_SHIFTER << col;
+
+    select_col(col);
+    matrix_output_select_delay();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (!gpio_read_pin(row_pins[row])) {
+            current_matrix[row] |= col_mask;
+            key_pressed = true;
+        }
+    }
+    unselect_col(col);
+    matrix_output_unselect_delay(col, key_pressed);
+    return key_pressed;
+}
+
+void matrix_init_custom(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        gpio_set_pin_input_high(row_pins[row]);
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        unselect_col(col);
+    }
+    last_key_active = timer_read32();
+}
+
+#if defined(EVENT_TRACE_ENABLE)
+static void trace_edges(const matrix_row_t previous[], const matrix_row_t scanned[]) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t edges = previous[row] ^ scanned[row];
+        for (uint8_t col = 0; edges; col++, edges >>= 1) {
+            if (edges & 1) {
+                event_trace(EVENT_TRACE_MATRIX_EDGE, EVENT_TRACE_KEY_ARG(row, col, scanned[row] & (MATRIX_ROW_SHIFTER << col)));
+            }
+        }
+    }
+}
+#endif
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    if (parked) {
+        if (!wake_pending) {
+            return false;
+        }
+        matrix_unpark();
+    }
+
+    matrix_row_t scanned[MATRIX_ROWS] = {0};
+    bool         any_pressed          = false;
+
+    sample_us = key_time_now_us();
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        any_pressed |= read_rows_on_col(scanned, col);
+    }
+
+    bool changed = memcmp(current_matrix, scanned, sizeof(scanned)) != 0;
+    if (changed) {
+#if defined(EVENT_TRACE_ENABLE)
+        trace_edges(current_matrix, scanned);
+#endif
+        memcpy(current_matrix, scanned, sizeof(scanned));
+    }
+
+    if (any_pressed) {
+        last_key_active = timer_read32();
+    } else if (timer_elapsed32(last_key_active) >= MATRIX_PARK_DELAY_MS) {
+        matrix_park();
+    }
+    return changed;
+}
+
+uint32_t matrix_sample_time_us(void) {
+    return sample_us;
+}
+
+bool matrix_is_parked(void) {
+    return parked && !wake_pending;
+}
+
+// Sleeps until the next interrupt while the matrix is parked. With a periodic
+// system tick that is at most one tick, so RGB frames and timers keep running;
+// a key press wakes the core immediately through the row interrupt. Masking
+// interrupts around the check closes the race with that interrupt: WFI still
+// returns on a pending one.
+void matrix_idle_wait(void) {
+#if CH_CFG_ST_TIMEDELTA == 0
+    __disable_irq();
+    if (matrix_is_parked()) {
+        __WFI();
+    }
+    __enable_irq();
+#endif
+}
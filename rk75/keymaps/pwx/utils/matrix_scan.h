@@ -0,0 +1,18 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include <stdbool.h>
+
+// Custom "lite" matrix scanner with an idle mode. After MATRIX_PARK_DELAY_MS
+// with every key up, all columns are driven low and the row inputs are armed
+// for falling-edge interrupts; scanning stops until a row changes.
+
+#ifndef MATRIX_PARK_DELAY_MS
+#    define MATRIX_PARK_DELAY_MS 50
+#endif
+
+bool matrix_is_parked(void);
+void matrix_idle_wait(void);
+
+// key_time_now_us() when the latest scan started reading the rows.
+uint32_t matrix_sample_time_us(void);
@@ -0,0 +1,197 @@
+#include "reactive_keys.h"
+
+#include <string.h>
+#include "rgb_matrix.h"
+#include "color_swar.h"
+#include "rgb_driver.h"
+#include "led_layout.h"
+
+#define LED_MASK_BYTES ((RGB_MATRIX_LED_COUNT + 7) / 8)
+
+_Static_assert(LED_LAYOUT_COUNT == RGB_MATRIX_LED_COUNT, "led_layout.h is out of date with keyboard.json");
+
+static uint16_t hit_at[RGB_MATRIX_LED_COUNT];
+static uint8_t  active[LED_MASK_BYTES];
+static uint8_t  unsent[LED_MASK_BYTES]; // hits not yet on the LEDs
+static uint8_t  active_count = 0;
+static bool     any_unsent   = false;
+
+// Base colour of the last render, so the immediate write matches it.
+static HSV last_base = {0};
+
+static inline bool led_bit(const uint8_t *mask, uint8_t led) {
+    return mask[led / 8] & (1 << (led % 8));
+}
+
+// How a hit spreads from its key, read from the generated layout tables.
+typedef enum {
+    SHAPE_NONE = 0,
+    SHAPE_KEY,    // the key alone
+    SHAPE_WIDE,   // every LED, dimmer with distance
+    SHAPE_CROSS,  // along the key's row and column
+    SHAPE_SPLASH, // a ring moving out from the key
+} shape_t;
+
+static shape_t current_shape(void) {
+    if (!rgb_matrix_is_enabled()) {
+        return SHAPE_NONE;
+    }
+    switch (rgb_matrix_get_mode()) {
+#if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE)
+        case RGB_MATRIX_SOLID_REACTIVE_SIMPLE:
+#endif
+#if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE)
+        case RGB_MATRIX_SOLID_REACTIVE:
+#endif
+            return SHAPE_KEY;
+#if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE)
+        case RGB_MATRIX_SOLID_REACTIVE_WIDE:
+#endif
+#if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE)
+        case RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE:
+#endif
+            return SHAPE_WIDE;
+#if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS)
+        case RGB_MATRIX_SOLID_REACTIVE_CROSS:
+#endif
+#if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS)
+        case RGB_MATRIX_SOLID_REACTIVE_MULTICROSS:
+#endif
+#if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS)
+        case RGB_MATRIX_SOLID_REACTIVE_NEXUS:
+#endif
+#if defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS)
+        case RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS:
+#endif
+            return SHAPE_CROSS;
+#if defined(ENABLE_RGB_MATRIX_SPLASH)
+        case RGB_MATRIX_SPLASH:
+#endif
+#if defined(ENABLE_RGB_MATRIX_MULTISPLASH)
+        case RGB_MATRIX_MULTISPLASH:
+#endif
+#if defined(ENABLE_RGB_MATRIX_SOLID_SPLASH)
+        case RGB_MATRIX_SOLID_SPLASH:
+#endif
+#if defined(ENABLE_RGB_MATRIX_SOLID_MULTISPLASH)
+        case RGB_MATRIX_SOLID_MULTISPLASH:
+#endif
+            return SHAPE_SPLASH;
+        default:
+            return SHAPE_NONE;
+    }
+}
+
+static rgb_pixel_t hit_color(HSV base) {
+    return rgb_pixel_from_hsv(base.h + REACTIVE_KEYS_HUE_SHIFT, base.s, base.v);
+}
+
+void reactive_keys_press(uint8_t row, uint8_t col) {
+    // Only the base layers show the reaction; the others belong to indicators.
+    if (row >= MATRIX_ROWS || col >= MATRIX_COLS || get_highest_layer(layer_state | default_layer_state) > 2 || current_shape() == SHAPE_NONE) {
+        return;
+    }
+    uint8_t led = matrix_to_led[row][col];
+    if (led == NO_LED) {
+        return;
+    }
+    if (!led_bit(active, led)) {
+        active[led / 8] |= 1 << (led % 8);
+        active_count++;
+    }
+    hit_at[led] = timer_read();
+    unsent[led / 8] |= 1 << (led % 8);
+    any_unsent = true;
+}
+
+void reactive_keys_task(void) {
+    if (!any_unsent) {
+        return;
+    }
+    any_unsent      = false;
+    rgb_pixel_t hit = hit_color(last_base);
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        if (led_bit(unsent, led)) {
+            rgb_driver_show_pixel(led, hit);
+        }
+    }
+    memset(unsent, 0, sizeof(unsent));
+    rgb_driver_write_shown();
+}
+
+// Lowers fade[led] to the hit's fade at that LED, if it is in the chunk.
+static inline void paint(uint8_t *fade, uint8_t led, uint8_t led_min, uint8_t led_max, uint32_t value) {
+    if (led >= led_min && led < led_max && value < fade[led]) {
+        fade[led] = value;
+    }
+}
+
+// Same timing as QMK's reactive effects: the hit has faded after
+// 255 * 256 / (speed + 1) ms. Around the key, WIDE and CROSS fade
+// REACTIVE_KEYS_SPREAD steps further per unit of distance, and a SPLASH ring
+// reaches an LED after as many steps as it is far from the key. Distances and
+// the row and column walks come from the tables in led_layout.c, so a frame
+// costs no square roots.
+void reactive_keys_render(uint8_t led_min, uint8_t led_max, HSV base) {
+    last_base = base;
+    if (active_count == 0) {
+        return;
+    }
+    static uint8_t fade[RGB_MATRIX_LED_COUNT]; // 255: not lit by any hit
+    memset(fade + led_min, 255, led_max - led_min);
+
+    shape_t  shape  = current_shape();
+    uint32_t retire = shape == SHAPE_SPLASH ? 255 + 255 : 255;
+    uint8_t  speed  = qadd8(rgb_matrix_config.speed, 1);
+    uint8_t  left   = active_count;
+    for (uint8_t key = 0; left; key++) {
+        if (!led_bit(active, key)) {
+            continue;
+        }
+        left--;
+        uint32_t progress = (uint32_t)timer_elapsed(hit_at[key]) * speed / 256;
+        if (progress >= retire) {
+            active[key / 8] &= ~(1 << (key % 8));
+            active_count--;
+            continue;
+        }
+        const uint8_t *distance = led_distance[key];
+        switch (shape) {
+            case SHAPE_WIDE:
+                for (uint8_t led = led_min; led < led_max; led++) {
+                    paint(fade, led, led_min, led_max, progress + distance[led] * REACTIVE_KEYS_SPREAD);
+                }
+                break;
+            case SHAPE_CROSS:
+                paint(fade, key, led_min, led_max, progress);
+                for (uint8_t dir = 0; dir < LED_NEIGHBOR_COUNT; dir++) {
+                    for (uint8_t led = led_neighbors[key][dir]; led != NO_LED; led = led_neighbors[led][dir]) {
+                        uint32_t value = progress + distance[led] * REACTIVE_KEYS_SPREAD;
+                        if (value >= 255) {
+                            break;
+                        }
+                        paint(fade, led, led_min, led_max, value);
+                    }
+                }
+                break;
+            case SHAPE_SPLASH:
+                for (uint8_t led = led_min; led < led_max; led++) {
+                    if (progress >= distance[led]) {
+                        paint(fade, led, led_min, led_max, progress - distance[led]);
+                    }
+                }
+                break;
+            default:
+                paint(fade, key, led_min, led_max, progress);
+                break;
+        }
+    }
+
+    rgb_pixel_t hit  = hit_color(base);
+    rgb_pixel_t rest = rgb_pixel_from_hsv(base.h, base.s, base.v);
+    for (uint8_t led = led_min; led < led_max; led++) {
+        if (fade[led] < 255) {
+            rgb_driver_set_pixel(led, rgb_pixel_lerp(hit, rest, fade[led]));
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Key-press reaction for the reactive RGB modes (SOLID_REACTIVE*, SPLASH and
+// friends). The indicator pass paints every LED on the base layers, which
+// hides whatever the effect rendered, so the keymap draws the reaction
+// itself: the pressed key lights up in the SOLID_REACTIVE hit colour and
+// fades back to the base colour at the effect speed. The WIDE, CROSS, NEXUS
+// and SPLASH modes spread the hit over the keys around it, using the
+// distance and neighbour tables generated into led_layout.c.
+//
+// The render only reaches a key's LED when it gets to that LED's chunk of a
+// later frame. So the pressed LED is also written to the strip straight
+// away: from housekeeping, after the report has gone out, on top of what
+// the LEDs already show.
+
+// Hue offset of a fresh hit, as in QMK's SOLID_REACTIVE.
+#ifndef REACTIVE_KEYS_HUE_SHIFT
+#    define REACTIVE_KEYS_HUE_SHIFT 130
+#endif
+
+// Fade steps added per unit of distance from the key in the WIDE and CROSS
+// modes, as in QMK's SOLID_REACTIVE_WIDE.
+#ifndef REACTIVE_KEYS_SPREAD
+#    define REACTIVE_KEYS_SPREAD 5
+#endif
+
+void reactive_keys_press(uint8_t row, uint8_t col);
+void reactive_keys_task(void);
+
+// Draws the fading hits over the base colour; called from the indicator pass
+// on the base layers.
+void reactive_keys_render(uint8_t led_min, uint8_t led_max, HSV base);
@@ -0,0 +1,59 @@
+#include "report_watch.h"
+
+#include "host.h"
+
+static report_watch_callback_t callbacks[REPORT_WATCH_MAX_CALLBACKS];
+static uint8_t                 callback_count = 0;
+
+static host_driver_t  watched_driver;
+static host_driver_t *original_driver = NULL;
+
+static void report_sent(void) {
+    host_set_driver(original_driver);
+    uint8_t count  = callback_count;
+    callback_count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        callbacks[i]();
+    }
+}
+
+static void send_keyboard_watched(report_keyboard_t *report) {
+    report_sent();
+    original_driver->send_keyboard(report);
+}
+
+static void send_nkro_watched(report_nkro_t *report) {
+    report_sent();
+    original_driver->send_nkro(report);
+}
+
+static void send_extra_watched(report_extra_t *report) {
+    report_sent();
+    original_driver->send_extra(report);
+}
+
+// Nothing is installed while the protocol layer has no driver yet; the
+// callbacks stay armed and the next report_watch_arm() call retries.
+static void install_watcher(void) {
+    host_driver_t *driver = host_get_driver();
+    if (callback_count == 0 || driver == NULL || driver == &watched_driver) {
+        return;
+    }
+    original_driver              = driver;
+    watched_driver               = *original_driver;
+    watched_driver.send_keyboard = send_keyboard_watched;
+    watched_driver.send_nkro     = send_nkro_watched;
+    watched_driver.send_extra    = send_extra_watched;
+    host_set_driver(&watched_driver);
+}
+
+void report_watch_arm(report_watch_callback_t callback) {
+    bool armed = false;
+    for (uint8_t i = 0; i < callback_count; i++) {
+        armed |= callbacks[i] == callback;
+    }
+    if (!armed && callback_count < REPORT_WATCH_MAX_CALLBACKS) {
+        callbacks[callback_count++] = callback;
+    }
+    install_watcher();
+}
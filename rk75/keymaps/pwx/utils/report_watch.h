@@ -0,0 +1,16 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// One-shot notification for the next report sent to the host. Arming swaps
+// in a copy of the host driver whose keyboard, NKRO and extra-key hooks run
+// the armed callbacks before forwarding; the original driver is put back as
+// soon as they have run, so reports pay nothing while nothing is armed.
+
+#ifndef REPORT_WATCH_MAX_CALLBACKS
+#    define REPORT_WATCH_MAX_CALLBACKS 4
+#endif
+
+typedef void (*report_watch_callback_t)(void);
+
+void report_watch_arm(report_watch_callback_t callback);
@@ -0,0 +1,322 @@
+#include "rgb_driver.h"
+
+#include <string.h>
+#include "ch.h"
+#include "hal.h"
+#include "ws2812.h"
+#include "ws2812_encode.h"
+#include "event_trace.h"
+#include "hid_commands.h"
+#include "key_time.h"
+#if defined(CLOCK_GOVERNOR_ENABLE)
+#    include "clock_governor.h"
+#endif
+
+rgb_pixel_t rgb_driver_frame[RGB_MATRIX_LED_COUNT];
+
+// What the LEDs show once everything handed off has been sent; a flush that
+// would not change it is skipped. Main loop only.
+static rgb_pixel_t shown[RGB_MATRIX_LED_COUNT];
+
+static uint32_t frame_count = 0;
+
+// Owners holding the LEDs, one bit each, and the last frame of each. Frames
+// then come from rgb_driver_write() alone; the RGB matrix keeps rendering
+// but its flushes and per-pixel updates are not shown.
+static uint8_t            external = 0;
+static const rgb_pixel_t *external_frames[RGB_DRIVER_EXTERNAL_OWNERS];
+
+// Double-buffered handoff to the output thread: the main loop fills `handoff`
+// under the lock, the thread takes it into `sending` and owns the SPI
+// bitstream from there on. A frame handed off while the previous one is still
+// going out replaces any frame that was waiting, so the LEDs always get the
+// latest one.
+static rgb_pixel_t        handoff[RGB_MATRIX_LED_COUNT];
+static rgb_pixel_t        sending[RGB_MATRIX_LED_COUNT];
+static volatile bool      handoff_pending = false;
+static volatile bool      transferring    = false;
+static binary_semaphore_t handoff_ready;
+static thread_t          *output_thread;
+
+// The SPI bitstream of the LEDs, and the pixels it currently encodes. Only
+// LEDs whose pixel changed are encoded again; 0xFFFFFFFF is no pixel, so the
+// first frame encodes them all. ws2812_init() has set up the SPI peripheral,
+// but its own buffer is never used: frames are encoded here from packed
+// pixels rather than set LED by LED through ws2812_set_color().
+static uint32_t    spi_frame[WS2812_SPI_FRAME_WORDS(RGB_MATRIX_LED_COUNT)];
+static rgb_pixel_t encoded[RGB_MATRIX_LED_COUNT];
+
+// LED supply; main loop only.
+static bool     rail_on     = true;  // pwx.c powers it up at boot
+static bool     settling    = false;
+static bool     held        = false; // `shown` waits for the supply to settle
+static bool     dark        = false; // `shown` is all black
+static bool     gated       = false; // off because dark, as opposed to suspended
+static uint32_t rail_on_at  = 0;     // key_time_now_us()
+static uint32_t dark_since  = 0;
+static uint32_t gated_since = 0;
+
+static struct {
+    uint32_t gates;
+    uint32_t gated_ms;
+} power_stats;
+
+static THD_WORKING_AREA(rgb_output_wa, RGB_DRIVER_THREAD_STACK);
+
+static THD_FUNCTION(rgb_output_thread, arg) {
+    (void)arg;
+    chRegSetThreadName("rgb_output");
+    while (true) {
+        chBSemWait(&handoff_ready);
+        chSysLock();
+        memcpy(sending, handoff, sizeof(sending));
+        handoff_pending = false;
+        transferring    = true;
+        chSysUnlock();
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            if (sending[i] != encoded[i]) {
+                encoded[i] = sending[i];
+                ws2812_encode_pixel(spi_frame, i, sending[i]);
+            }
+        }
+        // This thread sleeps until the DMA transfer is done, so the SPI
+        // buffer is never re-encoded while it is being sent.
+        spiSend(&WS2812_SPI_DRIVER, sizeof(spi_frame), spi_frame);
+        transferring = false;
+    }
+}
+
+static void rgb_driver_init(void) {
+    ws2812_init();
+    memset(encoded, 0xFF, sizeof(encoded));
+    chBSemObjectInit(&handoff_ready, true);
+    output_thread = chThdCreateStatic(rgb_output_wa, sizeof(rgb_output_wa), RGB_DRIVER_THREAD_PRIORITY, rgb_output_thread, NULL);
+}
+
+static void rgb_driver_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_driver_frame[index] = RGB_PIXEL(r, g, b);
+    }
+}
+
+static void rgb_driver_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    rgb_pixel_fill(rgb_driver_frame, RGB_MATRIX_LED_COUNT, RGB_PIXEL(r, g, b));
+}
+
+static bool frame_is_dark(const rgb_pixel_t *frame) {
+    rgb_pixel_t any = 0;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        any |= frame[i];
+    }
+    return any == 0;
+}
+
+static void account_gated(void) {
+    uint32_t now = timer_read32();
+    power_stats.gated_ms += TIMER_DIFF_32(now, gated_since);
+    gated_since = now;
+}
+
+static void rail_off(bool gate) {
+    gpio_write_pin_low(LED_ENABLE_PIN);
+    rail_on  = false;
+    settling = false;
+    held     = false;
+    if (gate) {
+        gated       = true;
+        gated_since = timer_read32();
+        power_stats.gates++;
+    }
+}
+
+static void rail_up(void) {
+    if (gated) {
+        account_gated();
+        gated = false;
+    }
+    gpio_write_pin_high(LED_ENABLE_PIN);
+    rail_on    = true;
+    settling   = true;
+    rail_on_at = key_time_now_us();
+}
+
+static void hand_off(void) {
+#if defined(CLOCK_GOVERNOR_ENABLE)
+    // WS2812 bit timing is only right at full clock.
+    clock_governor_demand();
+#endif
+    chSysLock();
+    memcpy(handoff, shown, sizeof(handoff));
+    handoff_pending = true;
+    chBSemSignalI(&handoff_ready);
+    chSysUnlock();
+}
+
+// WS2812s come up dark, so a black frame needs no supply at all.
+static void send_shown(void) {
+    dark = frame_is_dark(shown);
+    if (dark) {
+        dark_since = timer_read32();
+        if (!rail_on) {
+            return;
+        }
+    } else if (!rail_on) {
+        rail_up();
+    }
+    if (settling) {
+        held = true;
+        return;
+    }
+    hand_off();
+}
+
+void rgb_driver_write(const rgb_pixel_t *frame) {
+    memcpy(shown, frame, sizeof(shown));
+    send_shown();
+}
+
+void rgb_driver_show_pixel(uint8_t index, rgb_pixel_t color) {
+    if (index < RGB_MATRIX_LED_COUNT && !external) {
+        rgb_driver_frame[index] = color;
+        shown[index]            = color;
+    }
+}
+
+void rgb_driver_write_shown(void) {
+    if (!external) {
+        send_shown();
+    }
+}
+
+static bool holds_top(rgb_driver_external_t owner) {
+    return external >> owner == 1;
+}
+
+void rgb_driver_take_external(rgb_driver_external_t owner) {
+    external |= 1 << owner;
+}
+
+void rgb_driver_write_external(rgb_driver_external_t owner, const rgb_pixel_t *frame) {
+    external |= 1 << owner;
+    external_frames[owner] = frame;
+    if (holds_top(owner)) {
+        rgb_driver_write(frame);
+    }
+}
+
+// Shows the top owner's last frame, if it has written one.
+static void write_top_external(void) {
+    uint8_t top = 31 - __builtin_clz(external);
+    if (external_frames[top]) {
+        rgb_driver_write(external_frames[top]);
+    }
+}
+
+void rgb_driver_release_external(rgb_driver_external_t owner) {
+    bool was_top = holds_top(owner);
+    external &= ~(1 << owner);
+    external_frames[owner] = NULL;
+    if (was_top && external) {
+        write_top_external();
+    }
+}
+
+void rgb_driver_restore(const rgb_pixel_t *frame) {
+    if (external) {
+        write_top_external();
+    } else {
+        rgb_driver_write(frame);
+    }
+}
+
+const rgb_pixel_t *rgb_driver_shown(void) {
+    return shown;
+}
+
+// The main loop never blocks on its own, so the lower-priority output thread
+// only runs when it is handed the CPU, once the iteration's reports are out.
+// It is ready both when a frame is waiting and when its DMA transfer has
+// ended: only then does it get to clear `transferring`. Dropping below its
+// priority lets it run at once, until it blocks on the next frame or DMA
+// again, instead of the loop sleeping out a whole tick.
+void rgb_driver_yield(void) {
+    if (output_thread->state == CH_STATE_READY) {
+        tprio_t prio = chThdSetPriority(RGB_DRIVER_THREAD_PRIORITY - 1);
+        chThdSetPriority(prio);
+    }
+}
+
+void rgb_driver_task(void) {
+    if (settling && TIMER_DIFF_32(key_time_now_us(), rail_on_at) >= RGB_DRIVER_POWER_UP_US) {
+        settling = false;
+        if (held) {
+            held = false;
+            hand_off();
+        }
+    }
+    if (rail_on && dark && !settling && !handoff_pending && !transferring && timer_elapsed32(dark_since) >= RGB_DRIVER_GATE_DELAY_MS) {
+        rail_off(true);
+    }
+}
+
+bool rgb_driver_idle(void) {
+    return !settling && !handoff_pending && !transferring;
+}
+
+void rgb_driver_power_suspend(void) {
+    if (gated) {
+        account_gated();
+        gated = false;
+    }
+    rail_off(false);
+}
+
+void rgb_driver_power_resume(void) {
+    rail_up();
+}
+
+static void rgb_driver_flush(void) {
+    frame_count++;
+    bool changed = !external && memcmp(shown, rgb_driver_frame, sizeof(shown)) != 0;
+    if (changed) {
+        rgb_driver_write(rgb_driver_frame);
+    }
+    event_trace(EVENT_TRACE_FRAME, changed);
+}
+
+uint32_t rgb_driver_frame_count(void) {
+    return frame_count;
+}
+
+// READ: [.., .., op, rail_on, gated, gates(4), gated_ms(4), gate_delay_ms(2)]
+void rgb_driver_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case RGB_DRIVER_OP_POWER_READ:
+            if (gated) {
+                account_gated();
+            }
+            payload[0] = rail_on;
+            payload[1] = gated;
+            pwx_hid_write_u32(&payload[2], power_stats.gates);
+            pwx_hid_write_u32(&payload[6], power_stats.gated_ms);
+            pwx_hid_write_u16(&payload[10], RGB_DRIVER_GATE_DELAY_MS);
+            break;
+        case RGB_DRIVER_OP_POWER_RESET:
+            if (gated) {
+                account_gated();
+            }
+            memset(&power_stats, 0, sizeof(power_stats));
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = rgb_driver_init,
+    .flush         = rgb_driver_flush,
+    .set_color     = rgb_driver_set_color,
+    .set_color_all = rgb_driver_set_color_all,
+};
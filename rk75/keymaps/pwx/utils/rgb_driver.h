@@ -0,0 +1,114 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "color_swar.h"
+
+// Custom RGB_MATRIX_DRIVER on top of the WS2812 SPI driver. Effects and
+// indicators write into a packed frame that is only handed to the LEDs on
+// flush, so the last complete frame can be kept, replayed or inspected.
+// Frames identical to what the LEDs already show are not sent again.
+//
+// Encoding a frame into the WS2812 bitstream and the SPI transfer run in a
+// separate thread below the main loop's priority. Pixels stay packed all the
+// way to the bitstream, and only LEDs that changed are encoded again. Flushing only hands the
+// frame over, so scanning and reports never wait for the LEDs.
+//
+// The driver also owns the LED supply (LED_ENABLE_PIN). Once the LEDs have
+// shown an all-black frame for RGB_DRIVER_GATE_DELAY_MS the rail is switched
+// off, since dark WS2812s still draw their idle current, and black frames
+// are not sent while it is off. The first frame that lights anything turns
+// it back on and goes out once the supply has settled, as does the first
+// frame after USB suspend, which turns the rail off regardless.
+
+#ifndef RGB_DRIVER_THREAD_PRIORITY
+#    define RGB_DRIVER_THREAD_PRIORITY (NORMALPRIO - 1)
+#endif
+
+#ifndef RGB_DRIVER_THREAD_STACK
+#    define RGB_DRIVER_THREAD_STACK 256
+#endif
+
+#ifndef RGB_DRIVER_GATE_DELAY_MS
+#    define RGB_DRIVER_GATE_DELAY_MS 2000
+#endif
+
+// Settling time for the LED supply after LED_ENABLE_PIN goes high again.
+#ifndef RGB_DRIVER_POWER_UP_US
+#    define RGB_DRIVER_POWER_UP_US 500
+#endif
+
+typedef enum {
+    RGB_DRIVER_OP_POWER_READ = 0x00,
+    RGB_DRIVER_OP_POWER_RESET,
+} rgb_driver_op_t;
+
+// Modules that take the LEDs away from the RGB matrix, lowest first. While
+// any of them holds the LEDs, the highest one's frames are shown.
+typedef enum {
+    RGB_DRIVER_EXTERNAL_GAME_MODE = 0,
+    RGB_DRIVER_EXTERNAL_LIGHT_STREAM,
+    RGB_DRIVER_EXTERNAL_OWNERS,
+} rgb_driver_external_t;
+
+_Static_assert(RGB_DRIVER_EXTERNAL_OWNERS <= 8, "rgb_driver: one bit per external owner");
+
+extern rgb_pixel_t rgb_driver_frame[RGB_MATRIX_LED_COUNT];
+
+// rgb_matrix_set_color() for a packed pixel.
+static inline void rgb_driver_set_pixel(uint8_t index, rgb_pixel_t color) {
+    if (index < RGB_MATRIX_LED_COUNT) {
+        rgb_driver_frame[index] = color;
+    }
+}
+
+// Sends a whole frame to the LEDs at once, bypassing the effect pipeline.
+void rgb_driver_write(const rgb_pixel_t *frame);
+
+// Takes the LEDs for `owner`; the RGB matrix's frames and per-pixel updates
+// are no longer shown, and the LEDs keep what they show until a frame comes.
+void rgb_driver_take_external(rgb_driver_external_t owner);
+
+// Takes the LEDs for `owner` and shows `frame` unless a higher owner holds
+// them. The frame must stay valid until the owner releases: a lower owner's
+// last frame is shown again when the higher one lets go.
+void rgb_driver_write_external(rgb_driver_external_t owner, const rgb_pixel_t *frame);
+
+// Gives the LEDs back. The next owner down shows its last frame again; with
+// none left, the RGB matrix takes over from its next flush.
+void rgb_driver_release_external(rgb_driver_external_t owner);
+
+// Releases a frame held back for the supply to settle and switches the rail
+// off once the LEDs have been dark long enough.
+void rgb_driver_task(void);
+
+// Gives the output thread a system tick when a frame is waiting for it; the
+// last thing the main loop does in an iteration.
+void rgb_driver_yield(void);
+
+// LED supply around USB suspend.
+void rgb_driver_power_suspend(void);
+void rgb_driver_power_resume(void);
+
+// Whether everything handed off is on the LEDs, with nothing held back for
+// the supply or waiting for the output thread.
+bool rgb_driver_idle(void);
+
+// What the LEDs show, or will once a held or pending frame is out.
+const rgb_pixel_t *rgb_driver_shown(void);
+
+// Puts a saved frame back after the supply was off. While an external owner
+// holds the LEDs the saved frame is ignored and the owner's last frame goes
+// back instead. Does not wait: the frame goes out from rgb_driver_task() once
+// the supply has settled.
+void rgb_driver_restore(const rgb_pixel_t *frame);
+
+// Replaces one pixel both in the frame being rendered and in what the LEDs
+// show; rgb_driver_write_shown() then sends it without waiting for the render
+// to finish the frame.
+void rgb_driver_show_pixel(uint8_t index, rgb_pixel_t color);
+void rgb_driver_write_shown(void);
+
+// Number of frames flushed by the RGB matrix since boot, sent or not.
+uint32_t rgb_driver_frame_count(void);
+
+void rgb_driver_hid_command(uint8_t *data, uint8_t length);
@@ -0,0 +1,123 @@
+#include "rgb_scheduler.h"
+
+#include <string.h>
+#include "cycle_counter.h"
+#include "hid_commands.h"
+#include "rgb_driver.h"
+#include "rgb_matrix.h"
+
+#if !defined(RGB_MATRIX_LED_PROCESS_LIMIT) || RGB_MATRIX_LED_PROCESS_LIMIT <= 0 || RGB_MATRIX_LED_PROCESS_LIMIT >= RGB_MATRIX_LED_COUNT
+#    error "rgb_scheduler: RGB_MATRIX_LED_PROCESS_LIMIT must split the frame into chunks"
+#endif
+
+// Every chunk of a frame, plus the pass that flushes it.
+#define CALLS_PER_FRAME ((RGB_MATRIX_LED_COUNT + RGB_MATRIX_LED_PROCESS_LIMIT - 1) / RGB_MATRIX_LED_PROCESS_LIMIT + 1)
+
+// A frame is open from its first chunk until the driver counts its flush.
+static bool     chunk_seen     = false;
+static uint32_t chunk_frame    = 0; // rgb_driver_frame_count() at the last chunk
+static bool     chunk_rendered = false;
+static uint32_t chunk_cycles   = 0; // running average, new samples weigh 1/8
+static uint32_t chunk_count    = 0;
+static bool     busy           = false;
+
+static uint32_t fps_window_start  = 0;
+static uint32_t fps_window_frames = 0;
+static uint16_t fps               = 0;
+
+static struct {
+    uint32_t passes;     // passes that found a frame open
+    uint32_t chunks;     // rendered from here, on top of QMK's own
+    uint32_t overruns;   // passes that rendered for longer than their budget
+    uint8_t  max_chunks; // most chunks rendered from here in one pass
+} stats;
+
+static bool frame_open(void) {
+    return chunk_seen && chunk_frame == rgb_driver_frame_count();
+}
+
+static void update_fps(void) {
+    uint32_t elapsed = timer_elapsed32(fps_window_start);
+    if (elapsed >= 1000) {
+        uint32_t frames   = rgb_driver_frame_count();
+        fps               = (frames - fps_window_frames) * 1000 / elapsed;
+        fps_window_frames = frames;
+        fps_window_start  = timer_read32();
+    }
+}
+
+void rgb_scheduler_chunk(uint8_t led_min, uint8_t led_max) {
+    (void)led_min;
+    (void)led_max;
+    chunk_seen     = true;
+    chunk_frame    = rgb_driver_frame_count();
+    chunk_rendered = true;
+    chunk_count++;
+}
+
+uint32_t rgb_scheduler_chunk_count(void) {
+    return chunk_count;
+}
+
+void rgb_scheduler_task(void) {
+    update_fps();
+    // QMK's own chunk for this pass has already been rendered; it is only
+    // known by its average cost.
+    bool rendered  = chunk_rendered;
+    chunk_rendered = false;
+    if (!frame_open()) {
+        return;
+    }
+
+    busy            = last_input_activity_elapsed() < RGB_SCHEDULER_BUSY_MS;
+    // Chunks cost about the same cycles at any clock; the budget is time.
+    uint32_t budget = (busy ? RGB_SCHEDULER_BUSY_BUDGET_US : RGB_SCHEDULER_IDLE_BUDGET_US) * cycle_counter_cycles_per_us();
+    uint32_t spent  = rendered ? chunk_cycles : 0;
+    uint8_t  chunks = 0;
+    stats.passes++;
+
+    for (uint8_t calls = 0; calls < CALLS_PER_FRAME && frame_open() && spent + chunk_cycles <= budget; calls++) {
+        uint32_t start = cycle_counter_read();
+        rgb_matrix_task();
+        uint32_t cycles = cycle_counter_read() - start;
+        spent += cycles;
+        // The call that flushes renders nothing and says nothing about chunks.
+        if (chunk_rendered) {
+            chunk_rendered = false;
+            chunk_cycles   = chunk_cycles ? chunk_cycles - chunk_cycles / 8 + cycles / 8 : cycles;
+            chunks++;
+        }
+    }
+
+    stats.chunks += chunks;
+    if (chunks > stats.max_chunks) {
+        stats.max_chunks = chunks;
+    }
+    if (spent > budget) {
+        stats.overruns++;
+    }
+}
+
+// READ: [.., .., op, busy, fps(2), chunk_us(2), budget_us(2), passes(4), chunks(4), overruns(4), max_chunks, leds_per_chunk]
+void rgb_scheduler_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case RGB_SCHEDULER_OP_READ:
+            payload[0] = busy;
+            pwx_hid_write_u16(&payload[1], fps);
+            pwx_hid_write_u16(&payload[3], cycle_counter_to_us(chunk_cycles));
+            pwx_hid_write_u16(&payload[5], busy ? RGB_SCHEDULER_BUSY_BUDGET_US : RGB_SCHEDULER_IDLE_BUDGET_US);
+            pwx_hid_write_u32(&payload[7], stats.passes);
+            pwx_hid_write_u32(&payload[11], stats.chunks);
+            pwx_hid_write_u32(&payload[15], stats.overruns);
+            payload[19] = stats.max_chunks;
+            payload[20] = RGB_MATRIX_LED_PROCESS_LIMIT;
+            break;
+        case RGB_SCHEDULER_OP_RESET:
+            memset(&stats, 0, sizeof(stats));
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Render budget for the RGB matrix. QMK renders one chunk of
+// RGB_MATRIX_LED_PROCESS_LIMIT LEDs per main loop pass, however busy the
+// pass already is. That limit is kept small here, and every pass that is
+// still inside a frame gets further chunks from housekeeping for as long as
+// they fit a per-pass budget: RGB_SCHEDULER_BUSY_BUDGET_US while keys are in
+// use, RGB_SCHEDULER_IDLE_BUDGET_US otherwise. So a typing burst only ever
+// waits behind one chunk, and an idle board still renders a frame in one or
+// two passes.
+//
+// A chunk's cost, effect and indicators together, is measured with the cycle
+// counter every time housekeeping renders one, and a running average decides
+// whether the next one fits. A pass whose rendering took longer than its
+// budget counts as an overrun.
+
+#ifndef RGB_SCHEDULER_BUSY_BUDGET_US
+#    define RGB_SCHEDULER_BUSY_BUDGET_US 60
+#endif
+
+#ifndef RGB_SCHEDULER_IDLE_BUDGET_US
+#    define RGB_SCHEDULER_IDLE_BUDGET_US 600
+#endif
+
+// Time after the last key or knob input during which the busy budget applies.
+#ifndef RGB_SCHEDULER_BUSY_MS
+#    define RGB_SCHEDULER_BUSY_MS 250
+#endif
+
+typedef enum {
+    RGB_SCHEDULER_OP_READ = 0x00,
+    RGB_SCHEDULER_OP_RESET,
+} rgb_scheduler_op_t;
+
+// Called from the indicator pass, once per rendered chunk.
+void rgb_scheduler_chunk(uint8_t led_min, uint8_t led_max);
+
+// Chunks rendered since boot, by QMK or from here.
+uint32_t rgb_scheduler_chunk_count(void);
+
+void rgb_scheduler_task(void);
+void rgb_scheduler_hid_command(uint8_t *data, uint8_t length);
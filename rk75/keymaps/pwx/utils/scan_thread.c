@@ -0,0 +1,275 @@
+#include "scan_thread.h"
+
+#include <string.h>
+#include "hal.h"
+#include "matrix.h"
+#include "debounce.h"
+#include "cycle_counter.h"
+#include "hid_commands.h"
+#include "key_event_queue.h"
+#include "key_time.h"
+#include "matrix_scan.h"
+
+#if !HAL_USE_GPT || !WB32_GPT_USE_TIM2 || !WB32_GPT_USE_TIM3
+#    error "scan_thread: needs HAL_USE_GPT, WB32_GPT_USE_TIM2 and WB32_GPT_USE_TIM3"
+#endif
+
+#if defined(CLOCK_GOVERNOR_ENABLE)
+#    error "scan_thread: the scan timer runs from APB, which the clock governor slows down"
+#endif
+
+#ifndef MATRIX_IO_DELAY
+#    define MATRIX_IO_DELAY 30 // QMK's default in matrix_common.c
+#endif
+
+// Two columns with keys down, as while typing, fit the period; a scan that
+// settles every column still samples well inside the debounce window.
+_Static_assert(2 * MATRIX_IO_DELAY < SCAN_THREAD_PERIOD_US, "scan_thread: a scan does not fit the period with this MATRIX_IO_DELAY");
+_Static_assert(MATRIX_COLS * MATRIX_IO_DELAY < DEBOUNCE * 1000, "scan_thread: a full scan takes longer than the debounce window");
+
+#define CYCLES_PER_US (CYCLE_COUNTER_HZ / 1000000UL)
+#define PERIOD_CYCLES (SCAN_THREAD_PERIOD_US * CYCLES_PER_US)
+
+// QMK's cooked matrix (matrix_common.c), read by matrix_task().
+extern matrix_row_t matrix[MATRIX_ROWS];
+
+static key_event_queue_t queue;
+
+// Scan thread only.
+static matrix_row_t raw[MATRIX_ROWS];
+static matrix_row_t debounced[MATRIX_ROWS];
+static matrix_row_t queued[MATRIX_ROWS]; // debounced state already in the queue
+static bool         backlog    = false;  // changes left over from a full queue
+static bool         timed      = false;  // last_start belongs to this run of the timer
+static uint32_t     last_start = 0;
+
+static binary_semaphore_t scan_due;
+static binary_semaphore_t settled;
+static volatile uint32_t  tick_at         = 0;
+static bool               running         = false; // timer state; under the lock
+static volatile bool      reset_requested = false;
+
+static struct {
+    uint32_t scans;
+    uint32_t overruns;
+    uint32_t min_period;
+    uint32_t max_period;
+    uint32_t max_wake;
+    uint32_t max_scan;
+    uint16_t queue_full;
+    uint8_t  queue_high_water;
+    uint16_t jitter[SCAN_THREAD_JITTER_BUCKETS];
+} stats;
+
+static THD_WORKING_AREA(scan_wa, SCAN_THREAD_STACK);
+
+static void reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+    stats.min_period = UINT32_MAX;
+}
+
+static void scan_tick(GPTDriver *gpt) {
+    (void)gpt;
+    chSysLockFromISR();
+    tick_at = cycle_counter_read();
+    if (!chBSemGetStateI(&scan_due)) {
+        // The previous tick has not been picked up yet.
+        stats.overruns++;
+    }
+    chBSemSignalI(&scan_due);
+    chSysUnlockFromISR();
+}
+
+static const GPTConfig scan_gpt_config = {
+    .frequency = 1000000,
+    .callback  = scan_tick,
+};
+
+static void settle_done(GPTDriver *gpt) {
+    (void)gpt;
+    chSysLockFromISR();
+    chBSemSignalI(&settled);
+    chSysUnlockFromISR();
+}
+
+static const GPTConfig settle_gpt_config = {
+    .frequency = 1000000,
+    .callback  = settle_done,
+};
+
+// Replaces QMK's weak delay after a column is released, which waits
+// MATRIX_IO_DELAY in wait_us() after every column. Called from the scan
+// thread only, as matrix_scan_custom() is.
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {
+    (void)line;
+    if (key_pressed) {
+        chSysLock();
+        gptStartOneShotI(&SCAN_THREAD_SETTLE_GPT, MATRIX_IO_DELAY);
+        chBSemWaitS(&settled);
+        chSysUnlock();
+    }
+}
+
+static void start_timer_i(void) {
+    if (!running) {
+        running = true;
+        timed   = false;
+        tick_at = cycle_counter_read();
+        gptStartContinuousI(&SCAN_THREAD_GPT, SCAN_THREAD_PERIOD_US);
+        // Scan straight away rather than one period after the wake-up.
+        chBSemSignalI(&scan_due);
+    }
+}
+
+void scan_thread_wake_from_isr(void) {
+    chSysLockFromISR();
+    start_timer_i();
+    chSysUnlockFromISR();
+}
+
+static void account_period(uint32_t start) {
+    if (reset_requested) {
+        reset_stats();
+        reset_requested = false;
+    }
+    stats.scans++;
+    stats.max_wake = MAX(stats.max_wake, start - tick_at);
+    if (timed) {
+        uint32_t period    = start - last_start;
+        uint32_t deviation = cycle_counter_to_us(period > PERIOD_CYCLES ? period - PERIOD_CYCLES : PERIOD_CYCLES - period);
+        uint8_t  bucket    = deviation ? MIN(32 - __builtin_clz(deviation), SCAN_THREAD_JITTER_BUCKETS - 1) : 0;
+        stats.min_period   = MIN(stats.min_period, period);
+        stats.max_period   = MAX(stats.max_period, period);
+        if (stats.jitter[bucket] != UINT16_MAX) {
+            stats.jitter[bucket]++;
+        }
+    }
+    timed      = true;
+    last_start = start;
+}
+
+// Queues every debounced change not queued yet, row by row. A full queue
+// leaves the rest for the next scan; the consumer frees slots on every pass
+// of the main loop, so that only delays events, it never drops them.
+static void publish(uint32_t sampled_us) {
+    backlog = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t changes = debounced[row] ^ queued[row];
+        for (uint8_t col = 0; changes; col++, changes >>= 1) {
+            if (!(changes & 1)) {
+                continue;
+            }
+            matrix_row_t mask  = MATRIX_ROW_SHIFTER << col;
+            key_event_t  event = {.time = sampled_us, .row = row, .col = col, .pressed = (debounced[row] & mask) != 0};
+            if (!key_event_queue_push(&queue, &event)) {
+                if (stats.queue_full != UINT16_MAX) {
+                    stats.queue_full++;
+                }
+                backlog = true;
+                return;
+            }
+            queued[row] ^= mask;
+        }
+    }
+    stats.queue_high_water = MAX(stats.queue_high_water, key_event_queue_count(&queue));
+}
+
+static THD_FUNCTION(scan_thread, arg) {
+    (void)arg;
+    chRegSetThreadName("matrix_scan");
+    while (true) {
+        chBSemWait(&scan_due);
+        uint32_t start = cycle_counter_read();
+        account_period(start);
+
+        bool changed = matrix_scan_custom(raw);
+        if (debounce(raw, debounced, MATRIX_ROWS, changed) || backlog) {
+            publish(matrix_sample_time_us());
+        }
+        stats.max_scan = MAX(stats.max_scan, cycle_counter_read() - start);
+
+        // Under the lock the row interrupt cannot slip in between the check
+        // and stopping the timer; an edge before it has already unparked.
+        chSysLock();
+        if (running && matrix_is_parked()) {
+            gptStopTimerI(&SCAN_THREAD_GPT);
+            running = false;
+        }
+        chSysUnlock();
+    }
+}
+
+void scan_thread_init(void) {
+    reset_stats();
+    chBSemObjectInit(&scan_due, true);
+    chBSemObjectInit(&settled, true);
+    gptStart(&SCAN_THREAD_GPT, &scan_gpt_config);
+    gptStart(&SCAN_THREAD_SETTLE_GPT, &settle_gpt_config);
+    chThdCreateStatic(scan_wa, sizeof(scan_wa), SCAN_THREAD_PRIORITY, scan_thread, NULL);
+    chSysLock();
+    start_timer_i();
+    chSysUnlock();
+}
+
+// Replaces QMK's weak matrix_scan(), which scanned and debounced in the main
+// loop. matrix_task() turns the difference from the previous call into key
+// events, so each key may change only once per call: the first event for a
+// key that already changed in this call stops the drain and waits for the
+// next one, which keeps every event and their order.
+uint8_t matrix_scan(void) {
+    matrix_row_t       touched[MATRIX_ROWS] = {0};
+    bool               changed              = false;
+    const key_event_t *event;
+    while ((event = key_event_queue_peek(&queue)) != NULL) {
+        matrix_row_t mask = MATRIX_ROW_SHIFTER << event->col;
+        if (touched[event->row] & mask) {
+            break;
+        }
+        touched[event->row] |= mask;
+        key_time_stamp(event->row, event->col, event->time);
+        if (event->pressed) {
+            matrix[event->row] |= mask;
+        } else {
+            matrix[event->row] &= ~mask;
+        }
+        key_event_queue_pop(&queue);
+        changed = true;
+    }
+    matrix_scan_kb();
+    return changed;
+}
+
+// Request:  [cmd, subsystem, op, ...]
+// READ:     [.., .., op, period_us(2), scans(4), overruns(4), min_period_us(2), max_period_us(2),
+//            max_wake_us(2), max_scan_us(2), queue_size, queue_high_water, queue_full(2)]
+// JITTER:   [.., .., op, count(2) * SCAN_THREAD_JITTER_BUCKETS]
+// Times are whole microseconds; the minimum period reads 0 before two scans.
+void scan_thread_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case SCAN_THREAD_OP_READ:
+            pwx_hid_write_u16(&payload[0], SCAN_THREAD_PERIOD_US);
+            pwx_hid_write_u32(&payload[2], stats.scans);
+            pwx_hid_write_u32(&payload[6], stats.overruns);
+            pwx_hid_write_u16(&payload[10], stats.min_period == UINT32_MAX ? 0 : cycle_counter_to_us(stats.min_period));
+            pwx_hid_write_u16(&payload[12], cycle_counter_to_us(stats.max_period));
+            pwx_hid_write_u16(&payload[14], cycle_counter_to_us(stats.max_wake));
+            pwx_hid_write_u16(&payload[16], cycle_counter_to_us(stats.max_scan));
+            payload[18] = KEY_EVENT_QUEUE_SIZE;
+            payload[19] = stats.queue_high_water;
+            pwx_hid_write_u16(&payload[20], stats.queue_full);
+            break;
+        case SCAN_THREAD_OP_JITTER:
+            for (uint8_t i = 0; i < SCAN_THREAD_JITTER_BUCKETS; i++) {
+                pwx_hid_write_u16(&payload[i * 2], stats.jitter[i]);
+            }
+            break;
+        case SCAN_THREAD_OP_RESET:
+            // The thread owns the statistics; it clears them before its next scan.
+            reset_requested = true;
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
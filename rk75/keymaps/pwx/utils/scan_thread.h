@@ -0,0 +1,57 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Fixed-rate matrix scanning, built only with SCAN_THREAD_ENABLE. A hardware
+// timer (TIM2) ticks every SCAN_THREAD_PERIOD_US and wakes a thread above the
+// main loop's priority, which scans the matrix, runs the debounce and pushes
+// the debounced changes into a lock-free queue (key_event_queue.h). The main
+// loop's matrix_scan() only drains that queue into QMK's matrix, so sampling
+// keeps its cadence whatever lighting, flash writes or deferred work the loop
+// is busy with, and key events are processed in the order they were seen.
+//
+// The timer stops while the matrix is parked and the row interrupt restarts
+// it. Scan timing is kept as jitter statistics, read over raw HID.
+//
+// Rows keep QMK's MATRIX_IO_DELAY to recover after a column is released,
+// but only after a column that had a key down: through the diodes, nothing
+// else pulls a row low. The thread sleeps out that time on a one-shot timer
+// (SCAN_THREAD_SETTLE_GPT) rather than spinning, so an idle matrix costs
+// only its pin reads and the main loop runs while rows settle. A scan with
+// keys down on more columns than fit the period runs over it, which is
+// counted as an overrun.
+
+#ifndef SCAN_THREAD_PERIOD_US
+#    define SCAN_THREAD_PERIOD_US 125
+#endif
+
+#ifndef SCAN_THREAD_PRIORITY
+#    define SCAN_THREAD_PRIORITY (NORMALPRIO + 1)
+#endif
+
+#ifndef SCAN_THREAD_STACK
+#    define SCAN_THREAD_STACK 512
+#endif
+
+#ifndef SCAN_THREAD_GPT
+#    define SCAN_THREAD_GPT GPTD2
+#endif
+
+#ifndef SCAN_THREAD_SETTLE_GPT
+#    define SCAN_THREAD_SETTLE_GPT GPTD3
+#endif
+
+// Buckets of |scan period - SCAN_THREAD_PERIOD_US|: under 1, 2, 4 ... 64 us
+// and 64 us or more.
+#define SCAN_THREAD_JITTER_BUCKETS 8
+
+typedef enum {
+    SCAN_THREAD_OP_READ = 0x00,
+    SCAN_THREAD_OP_JITTER,
+    SCAN_THREAD_OP_RESET,
+} scan_thread_op_t;
+
+void scan_thread_init(void);
+// Row interrupt while parked; called from the PAL callback.
+void scan_thread_wake_from_isr(void);
+void scan_thread_hid_command(uint8_t *data, uint8_t length);
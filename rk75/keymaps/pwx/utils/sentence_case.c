@@ -24,6 +24,10 @@
 
 #include <string.h>
 
+#if SENTENCE_CASE_TIMEOUT > 0
+#include "timer_wheel.h"
+#endif  // SENTENCE_CASE_TIMEOUT > 0
+
 #if !defined(IS_QK_MOD_TAP)
 // Attempt to detect out-of-date QMK installation, which would fail with
 // implicit-function-declaration errors in the code below.
@@ -51,7 +55,7 @@ enum {
 // clang-format on
 
 #if SENTENCE_CASE_TIMEOUT > 0
-static uint16_t idle_timer = 0;
+static timer_wheel_handle_t idle_timer = TIMER_WHEEL_INVALID;
 #endif  // SENTENCE_CASE_TIMEOUT > 0
 #if SENTENCE_CASE_BUFFER_SIZE > 1
 static uint16_t key_buffer[SENTENCE_CASE_BUFFER_SIZE] = {0};
@@ -80,7 +84,8 @@ static void set_sentence_state(uint8_t new_state) {
 
 static void clear_state_history(void) {
 #if SENTENCE_CASE_TIMEOUT > 0
-  idle_timer = 0;
+  timer_wheel_cancel(idle_timer);
+  idle_timer = TIMER_WHEEL_INVALID;
 #endif  // SENTENCE_CASE_TIMEOUT > 0
   memset(state_history, STATE_INIT, sizeof(state_history));
   if (sentence_state != STATE_DISABLED) {
@@ -121,16 +126,16 @@ bool is_sentence_case_on(void) { return sentence_state != STATE_DISABLED; }
 bool is_sentence_case_primed(void) { return sentence_state == STATE_PRIMED; }
 
 #if SENTENCE_CASE_TIMEOUT > 0
-#if SENTENCE_CASE_TIMEOUT < 100 || SENTENCE_CASE_TIMEOUT > 30000
-// Constrain timeout to a sensible range. With the 16-bit timer, the longest
-// representable timeout is 32768 ms, rounded here to 30000 ms = half a minute.
-#error "sentence_case: SENTENCE_CASE_TIMEOUT must be between 100 and 30000 ms"
+#if SENTENCE_CASE_TIMEOUT < 100
+// Constrain timeout to a sensible range.
+#error "sentence_case: SENTENCE_CASE_TIMEOUT must be at least 100 ms"
 #endif
 
-void sentence_case_task(void) {
-  if (idle_timer && timer_expired(timer_read(), idle_timer)) {
-    clear_state_history();  // Timed out; clear all state.
-  }
+static uint32_t idle_timeout(void* arg) {
+  (void)arg;
+  idle_timer = TIMER_WHEEL_INVALID;
+  clear_state_history();  // Timed out; clear all state.
+  return 0;
 }
 #endif  // SENTENCE_CASE_TIMEOUT > 0
 
@@ -141,7 +146,9 @@ bool process_sentence_case(uint16_t keycode, keyrecord_t* record) {
   }
 
 #if SENTENCE_CASE_TIMEOUT > 0
-  idle_timer = (record->event.time + SENTENCE_CASE_TIMEOUT) | 1;
+  // Restarted on every press, on the keymap's timer wheel.
+  timer_wheel_cancel(idle_timer);
+  idle_timer = timer_wheel_schedule(SENTENCE_CASE_TIMEOUT, idle_timeout, NULL);
 #endif  // SENTENCE_CASE_TIMEOUT > 0
 
   switch (keycode) {
@@ -65,20 +65,6 @@ extern "C" {
  */
 bool process_sentence_case(uint16_t keycode, keyrecord_t* record);
 
-/**
- * @fn sentence_case_task(void)
- * Matrix task function for Sentence Case.
- *
- * If using `SENTENCE_CASE_TIMEOUT`, call this function from your
- * `housekeeping_task_user()` function in keymap.c. (If no timeout is set,
- * calling `sentence_case_task()` has no effect.)
- */
-#if SENTENCE_CASE_TIMEOUT > 0
-void sentence_case_task(void);
-#else
-static inline void sentence_case_task(void) {}
-#endif
-
 void sentence_case_on(void); /**< Enables Sentence Case. */
 void sentence_case_off(void); /**< Disables Sentence Case. */
 void sentence_case_toggle(void); /**< Toggles Sentence Case. */
@@ -28,7 +28,11 @@ extern "C" {
 
 bool socd_cleaner_enabled = true;
 
+__attribute__((weak)) void socd_cleaner_update_user(uint8_t keycode,
+                                                    bool press) {}
+
 static void update_key(uint8_t keycode, bool press) {
+  socd_cleaner_update_user(keycode, press);
   if (press) {
     add_key(keycode);
   } else {
@@ -138,6 +138,12 @@ typedef struct {
 bool process_socd_cleaner(uint16_t keycode, keyrecord_t* record,
                           socd_cleaner_t* state);
 
+/**
+ * Optional callback, called whenever the cleaner presses or releases the
+ * opposing key of a pair in the report.
+ */
+void socd_cleaner_update_user(uint8_t keycode, bool press);
+
 /** Determines globally whether SOCD cleaner is enabled. */
 extern bool socd_cleaner_enabled;
 
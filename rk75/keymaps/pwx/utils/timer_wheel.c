@@ -0,0 +1,272 @@
+#include "timer_wheel.h"
+
+#include <string.h>
+#include "hid_commands.h"
+
+#define LEVELS 4
+#define SLOT_BITS 6
+#define SLOTS (1 << SLOT_BITS)
+#define NONE 0xFF
+
+typedef struct {
+    uint32_t               deadline;
+    timer_wheel_callback_t callback;
+    void                  *arg;
+    uint8_t                next;
+    uint8_t                prev;
+    uint8_t                slot; // level * SLOTS + slot within the level
+    uint8_t                generation;
+    bool                   used;
+} wheel_timer_t;
+
+static wheel_timer_t timers[TIMER_WHEEL_TIMERS];
+static uint8_t       heads[LEVELS * SLOTS];
+static uint64_t      occupied[LEVELS]; // one bit per non-empty slot
+static uint8_t       free_head         = NONE;
+static uint32_t      current           = 0; // last millisecond processed
+static bool          started           = false;
+static uint8_t       running           = NONE; // timer whose callback is running
+static bool          running_cancelled = false;
+static uint8_t       pending           = 0;
+
+static struct {
+    uint32_t scheduled;
+    uint32_t fired;
+    uint32_t cancelled;
+    uint32_t cascades;    // timers moved down a level
+    uint16_t late_max_ms; // deadline to callback
+    uint8_t  peak_pending;
+} stats;
+
+static void start(void) {
+    if (started) {
+        return;
+    }
+    started = true;
+    memset(heads, NONE, sizeof(heads));
+    for (uint8_t i = 0; i < TIMER_WHEEL_TIMERS; i++) {
+        timers[i].next = free_head;
+        free_head      = i;
+    }
+    current = timer_read32();
+}
+
+static void link(uint8_t index) {
+    wheel_timer_t *timer = &timers[index];
+    uint32_t       delta = timer->deadline - current;
+    uint8_t        level = 0;
+    while (level < LEVELS - 1 && delta >= 1UL << (SLOT_BITS * (level + 1))) {
+        level++;
+    }
+    uint8_t shift = SLOT_BITS * level;
+    // Past the top level's span: wait for its slot to come round once more,
+    // then get placed again from there.
+    uint32_t at   = delta >> (SLOT_BITS * LEVELS) ? current : timer->deadline;
+    uint8_t  slot = (at >> shift) & (SLOTS - 1);
+
+    timer->slot = level * SLOTS + slot;
+    timer->prev = NONE;
+    timer->next = heads[timer->slot];
+    if (timer->next != NONE) {
+        timers[timer->next].prev = index;
+    }
+    heads[timer->slot] = index;
+    occupied[level] |= 1ULL << slot;
+}
+
+static void unlink(uint8_t index) {
+    wheel_timer_t *timer = &timers[index];
+    if (timer->prev != NONE) {
+        timers[timer->prev].next = timer->next;
+    } else {
+        heads[timer->slot] = timer->next;
+    }
+    if (timer->next != NONE) {
+        timers[timer->next].prev = timer->prev;
+    }
+    if (heads[timer->slot] == NONE) {
+        occupied[timer->slot / SLOTS] &= ~(1ULL << (timer->slot % SLOTS));
+    }
+}
+
+static void release(uint8_t index) {
+    wheel_timer_t *timer = &timers[index];
+    timer->used          = false;
+    timer->next          = free_head;
+    timer->generation++;
+    free_head = index;
+    pending--;
+}
+
+static wheel_timer_t *lookup(timer_wheel_handle_t handle) {
+    uint8_t index = (handle & 0xFF) - 1;
+    if (handle == TIMER_WHEEL_INVALID || index >= TIMER_WHEEL_TIMERS) {
+        return NULL;
+    }
+    wheel_timer_t *timer = &timers[index];
+    if (!timer->used || timer->generation != handle >> 8 || (index == running && running_cancelled)) {
+        return NULL;
+    }
+    return timer;
+}
+
+// The next millisecond at which a slot that holds anything comes round.
+static bool next_event(uint32_t *tick) {
+    bool     found = false;
+    uint32_t best  = 0;
+    for (uint8_t level = 0; level < LEVELS; level++) {
+        uint64_t mask = occupied[level];
+        if (!mask) {
+            continue;
+        }
+        uint8_t  shift   = SLOT_BITS * level;
+        uint32_t base    = current >> shift;
+        uint8_t  first   = (base + 1) & (SLOTS - 1);
+        uint64_t rotated = first ? (mask >> first) | (mask << (SLOTS - first)) : mask;
+        uint32_t at      = (base + 1 + __builtin_ctzll(rotated)) << shift;
+        if (!found || at - current < best - current) {
+            best  = at;
+            found = true;
+        }
+    }
+    *tick = best;
+    return found;
+}
+
+static void fire(uint8_t index) {
+    wheel_timer_t *timer = &timers[index];
+    uint32_t       now   = timer_read32();
+    uint32_t       late  = TIMER_DIFF_32(now, timer->deadline);
+    stats.fired++;
+    stats.late_max_ms = MAX(stats.late_max_ms, MIN(late, UINT16_MAX));
+
+    running           = index;
+    running_cancelled = false;
+    uint32_t again    = timer->callback(timer->arg);
+    running           = NONE;
+
+    if (again && !running_cancelled) {
+        timer->deadline = timer_read32() + again;
+        link(index);
+    } else {
+        release(index);
+    }
+}
+
+static void process(uint32_t tick) {
+    current = tick;
+    // Higher levels first, so a timer can move down several at once.
+    for (uint8_t level = LEVELS - 1; level > 0; level--) {
+        uint8_t shift = SLOT_BITS * level;
+        if (tick & ((1UL << shift) - 1)) {
+            continue;
+        }
+        uint8_t slot                = (tick >> shift) & (SLOTS - 1);
+        uint8_t index               = heads[level * SLOTS + slot];
+        heads[level * SLOTS + slot] = NONE;
+        occupied[level] &= ~(1ULL << slot);
+        while (index != NONE) {
+            uint8_t next = timers[index].next;
+            link(index);
+            stats.cascades++;
+            index = next;
+        }
+    }
+    uint8_t slot = tick & (SLOTS - 1);
+    while (heads[slot] != NONE) {
+        uint8_t index = heads[slot];
+        unlink(index);
+        fire(index);
+    }
+}
+
+timer_wheel_handle_t timer_wheel_schedule(uint32_t delay_ms, timer_wheel_callback_t callback, void *arg) {
+    start();
+    if (free_head == NONE) {
+        return TIMER_WHEEL_INVALID;
+    }
+    uint8_t        index = free_head;
+    wheel_timer_t *timer = &timers[index];
+    free_head            = timer->next;
+
+    timer->deadline = timer_read32() + delay_ms;
+    // The current millisecond has already been processed.
+    if ((int32_t)(timer->deadline - current) <= 0) {
+        timer->deadline = current + 1;
+    }
+    timer->callback = callback;
+    timer->arg      = arg;
+    timer->used     = true;
+    link(index);
+
+    pending++;
+    stats.scheduled++;
+    stats.peak_pending = MAX(stats.peak_pending, pending);
+    return ((timer_wheel_handle_t)timer->generation << 8) | (index + 1);
+}
+
+bool timer_wheel_cancel(timer_wheel_handle_t handle) {
+    wheel_timer_t *timer = lookup(handle);
+    if (!timer) {
+        return false;
+    }
+    uint8_t index = timer - timers;
+    if (index == running) {
+        running_cancelled = true;
+    } else {
+        unlink(index);
+        release(index);
+    }
+    stats.cancelled++;
+    return true;
+}
+
+bool timer_wheel_pending(timer_wheel_handle_t handle) {
+    return lookup(handle) != NULL;
+}
+
+uint32_t timer_wheel_next_deadline(void) {
+    start();
+    uint32_t tick;
+    if (!next_event(&tick)) {
+        return TIMER_WHEEL_NO_DEADLINE;
+    }
+    uint32_t now = timer_read32();
+    return tick - current <= now - current ? 0 : tick - now;
+}
+
+void timer_wheel_task(void) {
+    start();
+    uint32_t now = timer_read32();
+    uint32_t tick;
+    // Empty slots in between are skipped, not stepped through.
+    while (current != now && next_event(&tick) && tick - current <= now - current) {
+        process(tick);
+    }
+    current = now;
+}
+
+// READ: [.., .., op, pending, peak_pending, timers, next_ms(4), scheduled(4), fired(4), cancelled(4), cascades(4), late_max_ms(2)]
+void timer_wheel_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case TIMER_WHEEL_OP_READ:
+            payload[0] = pending;
+            payload[1] = stats.peak_pending;
+            payload[2] = TIMER_WHEEL_TIMERS;
+            pwx_hid_write_u32(&payload[3], timer_wheel_next_deadline());
+            pwx_hid_write_u32(&payload[7], stats.scheduled);
+            pwx_hid_write_u32(&payload[11], stats.fired);
+            pwx_hid_write_u32(&payload[15], stats.cancelled);
+            pwx_hid_write_u32(&payload[19], stats.cascades);
+            pwx_hid_write_u16(&payload[23], stats.late_max_ms);
+            break;
+        case TIMER_WHEEL_OP_RESET:
+            memset(&stats, 0, sizeof(stats));
+            stats.peak_pending = pending;
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
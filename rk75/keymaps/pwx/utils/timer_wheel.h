@@ -0,0 +1,57 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// One-shot and repeating timers for everything in the keymap that has to
+// happen a while from now. Deadlines are 32-bit millisecond timer_read32()
+// values, kept in a hierarchical wheel of four levels of 64 slots: level 0
+// holds the next 64 ms one slot per millisecond, each further level covers 64
+// times the span of the one below, and a timer moves down a level when its
+// slot comes round. Scheduling, cancelling and firing are O(1), and the task
+// jumps straight to the next slot that holds anything, so a long gap between
+// passes (USB suspend, a flash erase) costs no more than a short one.
+//
+// Callbacks run from timer_wheel_task() and return the delay to their next
+// run, or 0 when done; the handle stays valid for as long as the timer does.
+// Cancelling a timer that has finished does nothing, even once its place has
+// been reused, until that place has served 256 timers.
+
+// Timers pending at once; scheduling fails with TIMER_WHEEL_INVALID beyond.
+#ifndef TIMER_WHEEL_TIMERS
+#    define TIMER_WHEEL_TIMERS 16
+#endif
+
+_Static_assert(TIMER_WHEEL_TIMERS > 0 && TIMER_WHEEL_TIMERS < 255, "timer_wheel: TIMER_WHEEL_TIMERS must fit the handle's index byte");
+
+typedef uint16_t timer_wheel_handle_t;
+typedef uint32_t (*timer_wheel_callback_t)(void *arg);
+
+#define TIMER_WHEEL_INVALID ((timer_wheel_handle_t)0)
+
+// timer_wheel_next_deadline() with nothing scheduled.
+#define TIMER_WHEEL_NO_DEADLINE UINT32_MAX
+
+typedef enum {
+    TIMER_WHEEL_OP_READ = 0x00,
+    TIMER_WHEEL_OP_RESET,
+} timer_wheel_op_t;
+
+// Runs `callback` once `delay_ms` have passed; a delay of 0 runs it on the
+// next millisecond.
+timer_wheel_handle_t timer_wheel_schedule(uint32_t delay_ms, timer_wheel_callback_t callback, void *arg);
+
+// False if the timer already finished or was cancelled. A callback may cancel
+// its own timer; what it returns is then ignored.
+bool timer_wheel_cancel(timer_wheel_handle_t handle);
+
+bool timer_wheel_pending(timer_wheel_handle_t handle);
+
+// Milliseconds until the wheel next has work: a deadline, or a timer moving
+// down a level on its way to one. Never later than the earliest deadline;
+// 0 when that work is already due.
+uint32_t timer_wheel_next_deadline(void);
+
+// Once per main loop pass, and from the USB suspend loop.
+void timer_wheel_task(void);
+
+void timer_wheel_hid_command(uint8_t *data, uint8_t length);
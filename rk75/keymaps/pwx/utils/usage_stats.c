@@ -0,0 +1,193 @@
+#include "usage_stats.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "flash_spi.h"
+#include "event_trace.h"
+#include "hid_commands.h"
+
+#ifndef USAGE_STATS_FLASH_ADDRESS
+#    error "usage_stats: USAGE_STATS_FLASH_ADDRESS must point at a free flash region"
+#endif
+#ifndef USAGE_STATS_FLASH_SECTORS
+#    define USAGE_STATS_FLASH_SECTORS 2
+#endif
+
+// Snapshots are appended to fixed-size slots; a sector is erased only when the
+// log wraps into it, so a sector sees one erase per SLOTS_PER_SECTOR snapshots.
+#define USAGE_STATS_SLOT_SIZE 512
+#define USAGE_STATS_SLOTS_PER_SECTOR (EXTERNAL_FLASH_SECTOR_SIZE / USAGE_STATS_SLOT_SIZE)
+#define USAGE_STATS_SLOT_COUNT (USAGE_STATS_SLOTS_PER_SECTOR * USAGE_STATS_FLASH_SECTORS)
+#define USAGE_STATS_MAGIC 0x53545355 // "USTS"
+
+// Layout of the counters in a record. A record written with another version
+// or other dimensions is not loaded. Bump the version when what a counter
+// means changes without its size changing.
+#define USAGE_STATS_VERSION 1
+
+typedef struct {
+    uint32_t               magic;
+    uint8_t                version;
+    uint8_t                layers;
+    uint8_t                keycodes;
+    uint8_t                reserved;
+    uint32_t               sequence;
+    usage_stats_counters_t counters;
+    uint32_t               checksum;
+} usage_stats_record_t;
+
+_Static_assert(USAGE_STATS_LAYERS <= UINT8_MAX && USAGE_STATS_CUSTOM_KEYCODES <= UINT8_MAX, "usage_stats: counter dimensions must fit the record's layout bytes");
+_Static_assert(sizeof(usage_stats_record_t) <= USAGE_STATS_SLOT_SIZE, "usage_stats: record does not fit a slot");
+_Static_assert(USAGE_STATS_FLASH_ADDRESS >= EXTERNAL_FLASH_BLOCK_SIZE, "usage_stats: the first flash block is erased by wear-leveling compactions");
+
+usage_stats_counters_t usage_stats_counters;
+uint32_t               usage_stats_pending = 0;
+
+static uint32_t next_sequence      = 0;
+static uint32_t last_snapshot_time = 0;
+static bool     loaded             = false;
+static usage_stats_record_t record_buffer;
+
+static uint32_t checksum(const usage_stats_record_t *record) {
+    // FNV-1a over everything but the checksum itself.
+    const uint8_t *bytes = (const uint8_t *)record;
+    uint32_t       hash  = 2166136261u;
+    for (size_t i = 0; i < offsetof(usage_stats_record_t, checksum); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool current_layout(const usage_stats_record_t *record) {
+    return record->version == USAGE_STATS_VERSION && record->layers == USAGE_STATS_LAYERS && record->keycodes == USAGE_STATS_CUSTOM_KEYCODES;
+}
+
+static uint32_t slot_address(uint32_t slot) {
+    return USAGE_STATS_FLASH_ADDRESS + slot * USAGE_STATS_SLOT_SIZE;
+}
+
+// Presses counted before the load are added to the stored totals instead of
+// being overwritten by them, and stay pending for the next snapshot.
+static void merge_counters(const usage_stats_counters_t *stored) {
+    uint32_t       *total = (uint32_t *)&usage_stats_counters;
+    const uint32_t *add   = (const uint32_t *)stored;
+    for (size_t i = 0; i < sizeof(usage_stats_counters) / sizeof(uint32_t); i++) {
+        total[i] = total[i] > UINT32_MAX - add[i] ? UINT32_MAX : total[i] + add[i];
+    }
+}
+
+void usage_stats_load(void) {
+    bool     found = false;
+    uint32_t best  = 0;
+    for (uint32_t slot = 0; slot < USAGE_STATS_SLOT_COUNT; slot++) {
+        if (flash_read_block(slot_address(slot), &record_buffer, sizeof(record_buffer)) != FLASH_STATUS_SUCCESS) {
+            continue;
+        }
+        if (record_buffer.magic != USAGE_STATS_MAGIC || !current_layout(&record_buffer) || record_buffer.checksum != checksum(&record_buffer)) {
+            continue;
+        }
+        if (!found || record_buffer.sequence >= next_sequence) {
+            found         = true;
+            best          = slot;
+            next_sequence = record_buffer.sequence + 1;
+        }
+    }
+    if (found && flash_read_block(slot_address(best), &record_buffer, sizeof(record_buffer)) == FLASH_STATUS_SUCCESS) {
+        merge_counters(&record_buffer.counters);
+    }
+    loaded             = true;
+    last_snapshot_time = timer_read32();
+}
+
+bool usage_stats_snapshot(void) {
+    // Until the log has been read, the next slot is not known.
+    if (!loaded) {
+        return false;
+    }
+    uint32_t slot    = next_sequence % USAGE_STATS_SLOT_COUNT;
+    uint32_t address = slot_address(slot);
+
+    if (slot % USAGE_STATS_SLOTS_PER_SECTOR == 0) {
+        event_trace(EVENT_TRACE_FLASH, EVENT_TRACE_FLASH_ARG(EVENT_TRACE_SOURCE_USAGE_STATS, EVENT_TRACE_FLASH_ERASE));
+        if (flash_erase_sector(address) != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+
+    record_buffer.magic    = USAGE_STATS_MAGIC;
+    record_buffer.version  = USAGE_STATS_VERSION;
+    record_buffer.layers   = USAGE_STATS_LAYERS;
+    record_buffer.keycodes = USAGE_STATS_CUSTOM_KEYCODES;
+    record_buffer.reserved = 0;
+    record_buffer.sequence = next_sequence;
+    memcpy(&record_buffer.counters, &usage_stats_counters, sizeof(usage_stats_counters));
+    record_buffer.checksum = checksum(&record_buffer);
+
+    // The slot is consumed even on failure so a bad page is not retried forever.
+    next_sequence++;
+    last_snapshot_time = timer_read32();
+    event_trace(EVENT_TRACE_FLASH, EVENT_TRACE_FLASH_ARG(EVENT_TRACE_SOURCE_USAGE_STATS, EVENT_TRACE_FLASH_PROGRAM));
+    if (flash_write_block(address, &record_buffer, sizeof(record_buffer)) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    usage_stats_pending = 0;
+    return true;
+}
+
+void usage_stats_task(void) {
+    if (usage_stats_pending == 0) {
+        return;
+    }
+    if (last_input_activity_elapsed() < USAGE_STATS_IDLE_MS) {
+        return;
+    }
+    if (timer_elapsed32(last_snapshot_time) < USAGE_STATS_SNAPSHOT_INTERVAL_MS) {
+        return;
+    }
+    usage_stats_snapshot();
+}
+
+void usage_stats_reset(void) {
+    memset(&usage_stats_counters, 0, sizeof(usage_stats_counters));
+    usage_stats_pending = 1;
+}
+
+// Request:  [cmd, subsystem, op, offset_lo, offset_hi]
+// INFO:     [.., .., op, rows, cols, layers, keycodes, size_lo, size_hi, pending(4)]
+// READ:     [.., .., op, offset_lo, offset_hi, count, bytes...]
+void usage_stats_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case USAGE_STATS_OP_INFO:
+            payload[0] = MATRIX_ROWS;
+            payload[1] = MATRIX_COLS;
+            payload[2] = USAGE_STATS_LAYERS;
+            payload[3] = USAGE_STATS_CUSTOM_KEYCODES;
+            pwx_hid_write_u16(&payload[4], sizeof(usage_stats_counters));
+            pwx_hid_write_u32(&payload[6], usage_stats_pending);
+            break;
+        case USAGE_STATS_OP_READ: {
+            uint16_t       offset = pwx_hid_read_u16(&payload[0]);
+            uint8_t        count  = length - 6;
+            const uint8_t *source = (const uint8_t *)&usage_stats_counters;
+            if (offset >= sizeof(usage_stats_counters)) {
+                count = 0;
+            } else if (count > sizeof(usage_stats_counters) - offset) {
+                count = sizeof(usage_stats_counters) - offset;
+            }
+            payload[2] = count;
+            memcpy(&payload[3], source + offset, count);
+            break;
+        }
+        case USAGE_STATS_OP_RESET:
+            usage_stats_reset();
+            break;
+        case USAGE_STATS_OP_SNAPSHOT:
+            payload[0] = usage_stats_snapshot();
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include <stdbool.h>
+
+// Press counters kept in RAM and snapshotted to a dedicated region of the
+// external SPI flash while the keyboard is idle.
+
+#ifndef USAGE_STATS_LAYERS
+#    ifdef DYNAMIC_KEYMAP_LAYER_COUNT
+#        define USAGE_STATS_LAYERS DYNAMIC_KEYMAP_LAYER_COUNT
+#    else
+#        define USAGE_STATS_LAYERS 8
+#    endif
+#endif
+
+// Number of keycodes counted from SAFE_RANGE upwards.
+#ifndef USAGE_STATS_CUSTOM_KEYCODES
+#    define USAGE_STATS_CUSTOM_KEYCODES 24
+#endif
+
+// Time without any input before a pending snapshot is written.
+#ifndef USAGE_STATS_IDLE_MS
+#    define USAGE_STATS_IDLE_MS 30000
+#endif
+
+// Minimum time between two snapshots, to bound flash wear.
+#ifndef USAGE_STATS_SNAPSHOT_INTERVAL_MS
+#    define USAGE_STATS_SNAPSHOT_INTERVAL_MS 600000
+#endif
+
+typedef struct {
+    uint32_t keys[MATRIX_ROWS][MATRIX_COLS];
+    uint32_t layers[USAGE_STATS_LAYERS];
+    uint32_t keycodes[USAGE_STATS_CUSTOM_KEYCODES];
+} usage_stats_counters_t;
+
+typedef enum {
+    USAGE_STATS_OP_INFO = 0x00,
+    USAGE_STATS_OP_READ,
+    USAGE_STATS_OP_RESET,
+    USAGE_STATS_OP_SNAPSHOT,
+} usage_stats_op_t;
+
+void usage_stats_load(void);
+void usage_stats_task(void);
+void usage_stats_reset(void);
+bool usage_stats_snapshot(void);
+void usage_stats_hid_command(uint8_t *data, uint8_t length);
+
+extern usage_stats_counters_t usage_stats_counters;
+extern uint32_t usage_stats_pending;
+
+static inline void usage_stats_bump(uint32_t *counter) {
+    // Saturate instead of wrapping so a long-lived total never restarts at zero.
+    if (*counter != UINT32_MAX) {
+        (*counter)++;
+    }
+}
+
+// Called for every press from process_record_user(); kept inline so the key
+// path pays only a few increments.
+static inline void usage_stats_record(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        return;
+    }
+    keypos_t key = record->event.key;
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        usage_stats_bump(&usage_stats_counters.keys[key.row][key.col]);
+    }
+    uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+    if (layer < USAGE_STATS_LAYERS) {
+        usage_stats_bump(&usage_stats_counters.layers[layer]);
+    }
+    if (keycode >= SAFE_RANGE && keycode < SAFE_RANGE + USAGE_STATS_CUSTOM_KEYCODES) {
+        usage_stats_bump(&usage_stats_counters.keycodes[keycode - SAFE_RANGE]);
+    }
+    usage_stats_pending++;
+}
@@ -0,0 +1,151 @@
+#include "wear_leveling_metrics.h"
+
+#include <string.h>
+#include "flash_spi.h"
+#include "wear_leveling.h"
+#include "wear_leveling_internal.h"
+#include "boot_profile.h"
+#include "event_trace.h"
+#include "hid_commands.h"
+#include "key_time.h"
+
+_Static_assert(WEAR_LEVELING_FLASH_ADDRESS % EXTERNAL_FLASH_SECTOR_SIZE == 0, "wear_leveling: area must start on a sector");
+_Static_assert(WEAR_LEVELING_BACKING_SIZE % EXTERNAL_FLASH_SECTOR_SIZE == 0, "wear_leveling: area must be whole sectors");
+
+wear_leveling_metrics_t wear_leveling_metrics;
+
+static uint32_t stall_start;
+
+// Stalls are waits on the flash, so they are timed with a clock that keeps
+// its rate when the clock governor slows the core down.
+static void stall_begin(void) {
+    stall_start = key_time_now_us();
+}
+
+static void stall_end(void) {
+    uint32_t us = TIMER_DIFF_32(key_time_now_us(), stall_start);
+    wear_leveling_metrics.blocked_us += us;
+    if (us > wear_leveling_metrics.max_blocked_us) {
+        wear_leveling_metrics.max_blocked_us = us;
+    }
+}
+
+bool backing_store_init(void) {
+    boot_profile_mark(BOOT_MARK_WEAR_LEVELING);
+    flash_init();
+    return true;
+}
+
+bool backing_store_unlock(void) {
+    return true;
+}
+
+bool backing_store_lock(void) {
+    return true;
+}
+
+// QMK's spi_flash backend erases whole 64 KB blocks, which would also wipe
+// the keymap's regions behind the wear-leveling area; erase sector by sector.
+bool backing_store_erase(void) {
+    bool ok = true;
+    wear_leveling_metrics.compactions++;
+    event_trace(EVENT_TRACE_FLASH, EVENT_TRACE_FLASH_ARG(EVENT_TRACE_SOURCE_WEAR_LEVELING, EVENT_TRACE_FLASH_ERASE));
+    stall_begin();
+    for (uint32_t offset = 0; offset < WEAR_LEVELING_BACKING_SIZE; offset += EXTERNAL_FLASH_SECTOR_SIZE) {
+        if (flash_erase_sector(WEAR_LEVELING_FLASH_ADDRESS + offset) != FLASH_STATUS_SUCCESS) {
+            wear_leveling_metrics.failures++;
+            ok = false;
+            break;
+        }
+        wear_leveling_metrics.sector_erases++;
+    }
+    stall_end();
+    return ok;
+}
+
+// The core takes an all-zero word for an unused log slot while erased NOR
+// reads all ones, so words are stored inverted, as QMK's spi_flash backend
+// stores them.
+#define BULK_COUNT 8
+
+static bool program(uint32_t address, const backing_store_int_t *values, size_t item_count) {
+    backing_store_int_t inverted[BULK_COUNT];
+    size_t              bytes = item_count * sizeof(backing_store_int_t);
+    bool                ok    = true;
+    event_trace(EVENT_TRACE_FLASH, EVENT_TRACE_FLASH_ARG(EVENT_TRACE_SOURCE_WEAR_LEVELING, EVENT_TRACE_FLASH_PROGRAM));
+    stall_begin();
+    for (size_t done = 0; ok && done < item_count; done += BULK_COUNT) {
+        size_t count = MIN(item_count - done, BULK_COUNT);
+        for (size_t i = 0; i < count; i++) {
+            inverted[i] = ~values[done + i];
+        }
+        ok = flash_write_block(WEAR_LEVELING_FLASH_ADDRESS + address + done * sizeof(backing_store_int_t), inverted, count * sizeof(backing_store_int_t)) == FLASH_STATUS_SUCCESS;
+    }
+    stall_end();
+    if (ok) {
+        wear_leveling_metrics.programmed += bytes;
+    } else {
+        wear_leveling_metrics.failures++;
+    }
+    return ok;
+}
+
+// The core appends log entries one at a time and writes consolidated images
+// in bulk, which is what tells the two apart here.
+bool backing_store_write(uint32_t address, backing_store_int_t value) {
+    wear_leveling_metrics.log_appends++;
+    return program(address, &value, 1);
+}
+
+bool backing_store_write_bulk(uint32_t address, backing_store_int_t *values, size_t item_count) {
+    wear_leveling_metrics.bulk_writes++;
+    return program(address, values, item_count);
+}
+
+bool backing_store_read(uint32_t address, backing_store_int_t *value) {
+    return backing_store_read_bulk(address, value, 1);
+}
+
+bool backing_store_read_bulk(uint32_t address, backing_store_int_t *values, size_t item_count) {
+    if (flash_read_block(WEAR_LEVELING_FLASH_ADDRESS + address, values, item_count * sizeof(backing_store_int_t)) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    for (size_t i = 0; i < item_count; i++) {
+        values[i] = ~values[i];
+    }
+    return true;
+}
+
+// Request:  [cmd, subsystem, op, offset_lo, offset_hi]
+// INFO:     [.., .., op, backing_size(4), logical_size(4), write_size, metrics_size]
+// READ:     [.., .., op, offset_lo, offset_hi, count, bytes...]
+void wear_leveling_metrics_hid_command(uint8_t *data, uint8_t length) {
+    uint8_t *payload = &data[3];
+    switch (data[2]) {
+        case WEAR_LEVELING_METRICS_OP_INFO:
+            pwx_hid_write_u32(&payload[0], WEAR_LEVELING_BACKING_SIZE);
+            pwx_hid_write_u32(&payload[4], WEAR_LEVELING_LOGICAL_SIZE);
+            payload[8] = BACKING_STORE_WRITE_SIZE;
+            payload[9] = sizeof(wear_leveling_metrics);
+            break;
+        case WEAR_LEVELING_METRICS_OP_READ: {
+            uint16_t       offset = pwx_hid_read_u16(&payload[0]);
+            uint8_t        count  = length - 6;
+            const uint8_t *source = (const uint8_t *)&wear_leveling_metrics;
+            if (offset >= sizeof(wear_leveling_metrics)) {
+                count = 0;
+            } else if (count > sizeof(wear_leveling_metrics) - offset) {
+                count = sizeof(wear_leveling_metrics) - offset;
+            }
+            payload[2] = count;
+            memcpy(&payload[3], source + offset, count);
+            break;
+        }
+        case WEAR_LEVELING_METRICS_OP_RESET:
+            memset(&wear_leveling_metrics, 0, sizeof(wear_leveling_metrics));
+            break;
+        default:
+            data[1] = PWX_HID_UNHANDLED;
+            break;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Wear-leveling backing store on the external SPI flash, used as the custom
+// WEAR_LEVELING_DRIVER. It behaves like QMK's spi_flash backend but erases
+// only its own sectors and counts every program, erase and stall so the
+// write amplification of EEPROM traffic can be read back over raw HID.
+
+// Flash address of the wear-leveling area; WEAR_LEVELING_BACKING_SIZE long.
+#ifndef WEAR_LEVELING_FLASH_ADDRESS
+#    define WEAR_LEVELING_FLASH_ADDRESS 0
+#endif
+
+typedef struct {
+    uint32_t log_appends;    // single log entries, one or more per EEPROM write
+    uint32_t bulk_writes;    // consolidated images written after an erase
+    uint32_t programmed;     // bytes programmed, appends and bulk writes together
+    uint32_t compactions;    // backing store erases, including first-boot formatting
+    uint32_t sector_erases;  // flash sectors erased by those compactions
+    uint32_t failures;       // flash operations that did not succeed
+    uint32_t blocked_us;     // time spent inside programs and erases
+    uint32_t max_blocked_us; // longest single program or erase
+} wear_leveling_metrics_t;
+
+typedef enum {
+    WEAR_LEVELING_METRICS_OP_INFO = 0x00,
+    WEAR_LEVELING_METRICS_OP_READ,
+    WEAR_LEVELING_METRICS_OP_RESET,
+} wear_leveling_metrics_op_t;
+
+extern wear_leveling_metrics_t wear_leveling_metrics;
+
+void wear_leveling_metrics_hid_command(uint8_t *data, uint8_t length);
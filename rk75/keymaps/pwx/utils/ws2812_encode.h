@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include "color_swar.h"
+
+// WS2812 bitstream for the SPI driver, built straight from packed pixels. The
+// encoding is that of QMK's ws2812_spi: every SPI byte carries two LED bits,
+// each as 1000 (0) or 1110 (1), so one colour byte becomes four SPI bytes.
+// Those four bytes are looked up as one word for all eight bits at once
+// instead of being assembled two bits at a time, and a pixel goes out as
+// three word stores.
+
+// Same values as QMK's ws2812.h, for builds that do not include it.
+#ifndef WS2812_BYTE_ORDER_RGB
+#    define WS2812_BYTE_ORDER_RGB 0
+#    define WS2812_BYTE_ORDER_GRB 1
+#    define WS2812_BYTE_ORDER_BGR 2
+#endif
+#ifndef WS2812_BYTE_ORDER
+#    define WS2812_BYTE_ORDER WS2812_BYTE_ORDER_GRB
+#endif
+#ifndef WS2812_TRST_US
+#    define WS2812_TRST_US 280
+#endif
+#ifndef WS2812_TIMING
+#    define WS2812_TIMING 1250
+#endif
+
+_Static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "ws2812_encode: symbols are stored as little-endian words");
+
+// Four zero bytes ahead of the data hold the line low before the first bit,
+// and the line stays low for WS2812_TRST_US afterwards to latch the frame.
+#define WS2812_SPI_PREAMBLE_WORDS 1
+#define WS2812_SPI_RESET_BYTES (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
+#define WS2812_SPI_FRAME_WORDS(leds) (WS2812_SPI_PREAMBLE_WORDS + 3 * (leds) + (WS2812_SPI_RESET_BYTES + 3) / 4)
+
+#define WS2812_SPI_BIT(set) ((set) ? 0xEu : 0x8u)
+#define WS2812_SPI_PAIR(d, k) ((WS2812_SPI_BIT((d) & (0x80 >> (2 * (k)))) << 4) | WS2812_SPI_BIT((d) & (0x40 >> (2 * (k)))))
+#define WS2812_SPI_SYMBOL(d) (WS2812_SPI_PAIR(d, 0) | (WS2812_SPI_PAIR(d, 1) << 8) | (WS2812_SPI_PAIR(d, 2) << 16) | (WS2812_SPI_PAIR(d, 3) << 24))
+#define WS2812_SPI_SYMBOLS_4(d) WS2812_SPI_SYMBOL(d), WS2812_SPI_SYMBOL((d) + 1), WS2812_SPI_SYMBOL((d) + 2), WS2812_SPI_SYMBOL((d) + 3)
+#define WS2812_SPI_SYMBOLS_16(d) WS2812_SPI_SYMBOLS_4(d), WS2812_SPI_SYMBOLS_4((d) + 4), WS2812_SPI_SYMBOLS_4((d) + 8), WS2812_SPI_SYMBOLS_4((d) + 12)
+#define WS2812_SPI_SYMBOLS_64(d) WS2812_SPI_SYMBOLS_16(d), WS2812_SPI_SYMBOLS_16((d) + 16), WS2812_SPI_SYMBOLS_16((d) + 32), WS2812_SPI_SYMBOLS_16((d) + 48)
+
+// The four SPI bytes of every colour byte, first one sent in the low byte.
+static const uint32_t ws2812_spi_symbols[256] = {
+    WS2812_SPI_SYMBOLS_64(0),
+    WS2812_SPI_SYMBOLS_64(64),
+    WS2812_SPI_SYMBOLS_64(128),
+    WS2812_SPI_SYMBOLS_64(192),
+};
+
+// Writes the three words of LED `index` into a frame of WS2812_SPI_FRAME_WORDS.
+static inline void ws2812_encode_pixel(uint32_t *frame, uint8_t index, rgb_pixel_t px) {
+    uint32_t *out = &frame[WS2812_SPI_PREAMBLE_WORDS + 3 * index];
+#if WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB
+    out[0] = ws2812_spi_symbols[rgb_pixel_r(px)];
+    out[1] = ws2812_spi_symbols[rgb_pixel_g(px)];
+    out[2] = ws2812_spi_symbols[rgb_pixel_b(px)];
+#elif WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR
+    out[0] = ws2812_spi_symbols[rgb_pixel_b(px)];
+    out[1] = ws2812_spi_symbols[rgb_pixel_g(px)];
+    out[2] = ws2812_spi_symbols[rgb_pixel_r(px)];
+#else
+    out[0] = ws2812_spi_symbols[rgb_pixel_g(px)];
+    out[1] = ws2812_spi_symbols[rgb_pixel_r(px)];
+    out[2] = ws2812_spi_symbols[rgb_pixel_b(px)];
+#endif
+}
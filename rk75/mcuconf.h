@@ -11,6 +11,13 @@
 #undef WB32_SERIAL_USE_UART3
 #define WB32_SERIAL_USE_UART3 TRUE
 
+#if defined(SCAN_THREAD_ENABLE)
+#    undef WB32_GPT_USE_TIM2
+#    define WB32_GPT_USE_TIM2 TRUE
+#    undef WB32_GPT_USE_TIM3
+#    define WB32_GPT_USE_TIM3 TRUE
+#endif
+
 #undef WB32_SPI_USE_SPIM2
 #define WB32_SPI_USE_SPIM2 TRUE
 
@@ -2,10 +2,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include QMK_KEYBOARD_H
 #include "rgb_matrix.h"
+#include "keymaps/pwx/utils/boot_profile.h"
+#include "keymaps/pwx/utils/event_trace.h"
 #include "keymaps/pwx/utils/indicators.h"
-#define LED_ENABLE_PIN A5
+#include "keymaps/pwx/utils/rgb_driver.h"
 
 void keyboard_pre_init_kb(void) {
+    boot_profile_mark(BOOT_MARK_PRE_INIT);
+    event_trace_init();
     gpio_set_pin_output(LED_ENABLE_PIN);
     gpio_write_pin_high(LED_ENABLE_PIN);    
 
@@ -23,12 +27,12 @@ void keyboard_pre_init_user() {
 }
 
 void suspend_power_down_kb(void) {
-    gpio_write_pin_low(LED_ENABLE_PIN);
+    rgb_driver_power_suspend();
     suspend_power_down_user();
 }
 
 void suspend_wakeup_init_kb(void) {
-    gpio_write_pin_high(LED_ENABLE_PIN);
+    rgb_driver_power_resume();
     suspend_wakeup_init_user();
 }
 